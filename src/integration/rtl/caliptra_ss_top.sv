@@ -577,7 +577,12 @@ module caliptra_ss_top
     logic [127:0] cptra_ss_cptra_generic_fw_exec_ctrl_internal;
     assign cptra_ss_cptra_generic_fw_exec_ctrl_o = cptra_ss_cptra_generic_fw_exec_ctrl_internal[127:3];
 
+`ifdef CALIPTRA_CORE_TLM
+    // Transaction level stand-in for simulation, testbench/caliptra_top_tlm.sv
+    caliptra_top_tlm caliptra_top_dut (
+`else
     caliptra_top caliptra_top_dut (
+`endif
         .clk                        (cptra_ss_clk_i),
         .cptra_pwrgood              (cptra_ss_pwrgood_i),
         .cptra_rst_b                (mcu_cptra_rst_b),
@@ -991,6 +996,45 @@ module caliptra_ss_top
     // I3C-Core Instance
     //=========================================================================-
 
+`ifdef CSS_STUB_I3C
+    // Left out of the DUT profile, testbench/css_axi_stub.sv
+    css_axi_stub #(
+        .NAME("I3C"),
+        .IW  (`CALIPTRA_AXI_ID_WIDTH)
+    ) i3c_stub (
+        .clk    (cptra_ss_clk_i),
+        .rst_n  (cptra_ss_rst_b_i),
+        .awvalid(cptra_ss_i3c_s_axi_if.awvalid),
+        .awready(cptra_ss_i3c_s_axi_if.awready),
+        .awaddr (cptra_ss_i3c_s_axi_if.awaddr[31:0]),
+        .awid   (cptra_ss_i3c_s_axi_if.awid),
+        .wvalid (cptra_ss_i3c_s_axi_if.wvalid),
+        .wready (cptra_ss_i3c_s_axi_if.wready),
+        .wlast  (cptra_ss_i3c_s_axi_if.wlast),
+        .bvalid (cptra_ss_i3c_s_axi_if.bvalid),
+        .bready (cptra_ss_i3c_s_axi_if.bready),
+        .bresp  (cptra_ss_i3c_s_axi_if.bresp),
+        .bid    (cptra_ss_i3c_s_axi_if.bid),
+        .arvalid(cptra_ss_i3c_s_axi_if.arvalid),
+        .arready(cptra_ss_i3c_s_axi_if.arready),
+        .araddr (cptra_ss_i3c_s_axi_if.araddr[31:0]),
+        .arid   (cptra_ss_i3c_s_axi_if.arid),
+        .arlen  (cptra_ss_i3c_s_axi_if.arlen),
+        .rvalid (cptra_ss_i3c_s_axi_if.rvalid),
+        .rready (cptra_ss_i3c_s_axi_if.rready),
+        .rresp  (cptra_ss_i3c_s_axi_if.rresp),
+        .rid    (cptra_ss_i3c_s_axi_if.rid),
+        .rlast  (cptra_ss_i3c_s_axi_if.rlast)
+    );
+    assign cptra_ss_i3c_s_axi_if.rdata = '0;
+`ifdef DIGITAL_IO_I3C
+    assign cptra_ss_i3c_scl_o   = 1'b1;
+    assign cptra_ss_i3c_sda_o   = 1'b1;
+    assign cptra_ss_sel_od_pp_o = 1'b0;
+`endif
+    assign payload_available_o = 1'b0;
+    assign image_activated_o   = 1'b0;
+`else
     i3c_wrapper #(
         .AxiDataWidth(`AXI_DATA_WIDTH),
         .AxiAddrWidth(`AXI_ADDR_WIDTH),
@@ -1052,6 +1096,7 @@ module caliptra_ss_top
 
     // TODO: Add interrupts
     );
+`endif
 
     //=========================================================================
     // MCU ROM Interface Instance (Reuses MCI)
@@ -1199,6 +1244,96 @@ module caliptra_ss_top
 
     //--------------------------------------------------------------------------------------------
 
+`ifdef CSS_STUB_FC_LCC
+    // Fuse controller and LCC left out of the DUT profile. The MCI init
+    // handshakes complete a clock after the request, OTP data is never valid
+    // (MCI keeps the production, debug locked security state), the LC
+    // broadcast signals are off and both AXI subs answer with an error,
+    // testbench/css_axi_stub.sv.
+    always_ff @(posedge cptra_ss_clk_i or negedge cptra_ss_rst_b_i) begin
+        if (!cptra_ss_rst_b_i) begin
+            lcc_to_mci_lc_done            <= 1'b0;
+            otp_ctrl_to_mci_otp_ctrl_done <= 1'b0;
+        end
+        else begin
+            lcc_to_mci_lc_done            <= mci_to_lcc_init_req;
+            otp_ctrl_to_mci_otp_ctrl_done <= mci_to_otp_ctrl_init_req;
+        end
+    end
+
+    css_axi_stub #(
+        .NAME("LC ctrl"),
+        .IW  ($bits(cptra_ss_lc_axi_wr_req_i.awid))
+    ) lc_ctrl_stub (
+        .clk    (cptra_ss_clk_i),
+        .rst_n  (cptra_ss_rst_b_i),
+        .awvalid(cptra_ss_lc_axi_wr_req_i.awvalid),
+        .awready(cptra_ss_lc_axi_wr_rsp_o.awready),
+        .awaddr (32'(cptra_ss_lc_axi_wr_req_i.awaddr)),
+        .awid   (cptra_ss_lc_axi_wr_req_i.awid),
+        .wvalid (cptra_ss_lc_axi_wr_req_i.wvalid),
+        .wready (cptra_ss_lc_axi_wr_rsp_o.wready),
+        .wlast  (cptra_ss_lc_axi_wr_req_i.wlast),
+        .bvalid (cptra_ss_lc_axi_wr_rsp_o.bvalid),
+        .bready (cptra_ss_lc_axi_wr_req_i.bready),
+        .bresp  (cptra_ss_lc_axi_wr_rsp_o.bresp),
+        .bid    (cptra_ss_lc_axi_wr_rsp_o.bid),
+        .arvalid(cptra_ss_lc_axi_rd_req_i.arvalid),
+        .arready(cptra_ss_lc_axi_rd_rsp_o.arready),
+        .araddr (32'(cptra_ss_lc_axi_rd_req_i.araddr)),
+        .arid   (cptra_ss_lc_axi_rd_req_i.arid),
+        .arlen  (cptra_ss_lc_axi_rd_req_i.arlen),
+        .rvalid (cptra_ss_lc_axi_rd_rsp_o.rvalid),
+        .rready (cptra_ss_lc_axi_rd_req_i.rready),
+        .rresp  (cptra_ss_lc_axi_rd_rsp_o.rresp),
+        .rid    (cptra_ss_lc_axi_rd_rsp_o.rid),
+        .rlast  (cptra_ss_lc_axi_rd_rsp_o.rlast)
+    );
+    assign cptra_ss_lc_axi_rd_rsp_o.rdata = '0;
+
+    css_axi_stub #(
+        .NAME("Fuse ctrl"),
+        .IW  ($bits(cptra_ss_otp_core_axi_wr_req_i.awid))
+    ) otp_ctrl_stub (
+        .clk    (cptra_ss_clk_i),
+        .rst_n  (cptra_ss_rst_b_i),
+        .awvalid(cptra_ss_otp_core_axi_wr_req_i.awvalid),
+        .awready(cptra_ss_otp_core_axi_wr_rsp_o.awready),
+        .awaddr (32'(cptra_ss_otp_core_axi_wr_req_i.awaddr)),
+        .awid   (cptra_ss_otp_core_axi_wr_req_i.awid),
+        .wvalid (cptra_ss_otp_core_axi_wr_req_i.wvalid),
+        .wready (cptra_ss_otp_core_axi_wr_rsp_o.wready),
+        .wlast  (cptra_ss_otp_core_axi_wr_req_i.wlast),
+        .bvalid (cptra_ss_otp_core_axi_wr_rsp_o.bvalid),
+        .bready (cptra_ss_otp_core_axi_wr_req_i.bready),
+        .bresp  (cptra_ss_otp_core_axi_wr_rsp_o.bresp),
+        .bid    (cptra_ss_otp_core_axi_wr_rsp_o.bid),
+        .arvalid(cptra_ss_otp_core_axi_rd_req_i.arvalid),
+        .arready(cptra_ss_otp_core_axi_rd_rsp_o.arready),
+        .araddr (32'(cptra_ss_otp_core_axi_rd_req_i.araddr)),
+        .arid   (cptra_ss_otp_core_axi_rd_req_i.arid),
+        .arlen  (cptra_ss_otp_core_axi_rd_req_i.arlen),
+        .rvalid (cptra_ss_otp_core_axi_rd_rsp_o.rvalid),
+        .rready (cptra_ss_otp_core_axi_rd_req_i.rready),
+        .rresp  (cptra_ss_otp_core_axi_rd_rsp_o.rresp),
+        .rid    (cptra_ss_otp_core_axi_rd_rsp_o.rid),
+        .rlast  (cptra_ss_otp_core_axi_rd_rsp_o.rlast)
+    );
+    assign cptra_ss_otp_core_axi_rd_rsp_o.rdata = '0;
+
+    assign from_lcc_to_otp_program_i       = '0;
+    assign from_otp_to_lcc_data_i          = '0;
+    assign from_otp_to_clpt_core_broadcast = '0;
+    assign lc_dft_en_i                     = lc_ctrl_pkg::Off;
+    assign lc_hw_debug_en_i                = lc_ctrl_pkg::Off;
+    assign cptra_ss_lc_clk_byp_req_o       = lc_ctrl_pkg::Off;
+    assign cptra_ss_lc_ctrl_jtag_o         = '0;
+    assign cptra_ss_fuse_macro_prim_tl_o   = '0;
+    assign intr_otp_operation_done         = 1'b0;
+    assign fc_intr_otp_error               = 1'b0;
+    assign fc_alerts                       = '0;
+    assign lc_alerts_o                     = '0;
+`else
     assign lcc_to_mci_lc_done = pwrmgr_pkg::pwr_lc_rsp_t'(u_lc_ctrl.pwr_lc_o.lc_done);
     assign lcc_init_req.lc_init = mci_to_lcc_init_req; 
 
@@ -1320,6 +1455,7 @@ module caliptra_ss_top
         .cio_test_o                 (),    //TODO: Needs to be checked
         .cio_test_en_o              ()    //TODO: Needs to be checked
 	); 
+`endif
 
     // assign fuse_ctrl_rdy = 1;
     // De-assert cptra_rst_b only after fuse_ctrl has initialized
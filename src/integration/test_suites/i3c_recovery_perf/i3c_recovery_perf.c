@@ -0,0 +1,101 @@
+// Description: I3C recovery image streaming throughput
+// Comments   :
+//  Brings up the I3C core the same way as i3c_smoke, enables recovery mode
+//  and asks the TB I3C controller (css_i3c_ctrl, STDOUT command 0x8D) to
+//  stream the recovery image. The MCU plays the consumer: it drains
+//  INDIRECT_FIFO_DATA until the image size the controller wrote to
+//  INDIRECT_FIFO_CTRL has been read, timing the stream with mcycle.
+//  The result is printed as CSV between the 0x88/0x89 STDOUT commands.
+//  Image size and bus rate are TB plusargs, e.g.
+//    +I3C_REC_BYTES=65536 +I3C_SDR_KHZ=12500
+//  Needs a TB built without AVERY_I3C.
+
+#include "soc_address_map.h"
+#include "printf.h"
+#include "riscv_hw_if.h"
+#include "soc_ifc.h"
+#include <string.h>
+#include <stdint.h>
+
+volatile char* stdout = (char *)0x21000410;
+
+#ifdef CPT_VERBOSITY
+    enum printf_verbosity verbosity_g = CPT_VERBOSITY;
+#else
+    enum printf_verbosity verbosity_g = LOW;
+#endif
+
+static inline uint32_t read_mcycle(void) {
+    uint32_t val;
+    __asm__ volatile ("csrr %0, mcycle" : "=r" (val));
+    return val;
+}
+
+static void boot_i3c_core(void) {
+    uint32_t i3c_reg_data;
+
+    // SOCMGMTIF timing and bus enable
+    lsu_write_32(SOC_I3CCSR_I3C_EC_SOCMGMTIF_T_R_REG, 0x2);
+    lsu_write_32(SOC_I3CCSR_I3C_EC_SOCMGMTIF_T_HD_DAT_REG, 0xA);
+    lsu_write_32(SOC_I3CCSR_I3C_EC_SOCMGMTIF_T_SU_DAT_REG, 0xA);
+    lsu_write_32(SOC_I3CCSR_I3CBASE_HC_CONTROL, 1 << I3CCSR_I3CBASE_HC_CONTROL_BUS_ENABLE_LOW);
+
+    // Standby controller mode, target transactions enabled
+    i3c_reg_data = lsu_read_32(SOC_I3CCSR_I3C_EC_STDBYCTRLMODE_STBY_CR_CONTROL);
+    i3c_reg_data |= 2 << I3CCSR_I3C_EC_STDBYCTRLMODE_STBY_CR_CONTROL_STBY_CR_ENABLE_INIT_LOW;
+    i3c_reg_data |= 1 << I3CCSR_I3C_EC_STDBYCTRLMODE_STBY_CR_CONTROL_TARGET_XACT_ENABLE_LOW;
+    lsu_write_32(SOC_I3CCSR_I3C_EC_STDBYCTRLMODE_STBY_CR_CONTROL, i3c_reg_data);
+
+    // Static addresses: 0x5A for the device, 0x5B for the recovery target
+    lsu_write_32(SOC_I3CCSR_I3C_EC_STDBYCTRLMODE_STBY_CR_DEVICE_ADDR, 0x5A | (1 << 15));
+    lsu_write_32(SOC_I3CCSR_I3C_EC_STDBYCTRLMODE_STBY_CR_VIRT_DEVICE_ADDR, 0x5B | (1 << 15));
+
+    // Recovery mode
+    i3c_reg_data = lsu_read_32(SOC_I3CCSR_I3C_EC_SECFWRECOVERYIF_DEVICE_STATUS_0);
+    lsu_write_32(SOC_I3CCSR_I3C_EC_SECFWRECOVERYIF_DEVICE_STATUS_0, i3c_reg_data | 0x03);
+    VPRINTF(LOW, "MCU: I3C core up, recovery mode\n");
+}
+
+void main (void) {
+    uint32_t image_words = 0;
+    uint32_t words = 0;
+    uint32_t sum = 0;
+    uint32_t t_ctrl, t_first = 0, t_end;
+
+    VPRINTF(LOW, "=================\nI3C Recovery Stream Throughput\n=================\n\n")
+
+    boot_i3c_core();
+    SEND_STDOUT_CTRL(0x8D);
+
+    // INDIRECT_FIFO_CTRL bytes 2..5: image size in 4 byte words
+    while (!image_words) {
+        image_words = (lsu_read_32(SOC_I3CCSR_I3C_EC_SECFWRECOVERYIF_INDIRECT_FIFO_CTRL_0) >> 16) |
+                      (lsu_read_32(SOC_I3CCSR_I3C_EC_SECFWRECOVERYIF_INDIRECT_FIFO_CTRL_1) << 16);
+    }
+    t_ctrl = read_mcycle();
+
+    // No console output while draining, it would throttle the consumer
+    while (words < image_words) {
+        if (lsu_read_32(SOC_I3CCSR_I3C_EC_SECFWRECOVERYIF_INDIRECT_FIFO_STATUS_0) &
+            I3CCSR_I3C_EC_SECFWRECOVERYIF_INDIRECT_FIFO_STATUS_0_EMPTY_MASK) {
+            continue;
+        }
+        if (!words) {
+            t_first = read_mcycle();
+        }
+        sum += lsu_read_32(SOC_I3CCSR_I3C_EC_SECFWRECOVERYIF_INDIRECT_FIFO_DATA);
+        words++;
+    }
+    t_end = read_mcycle();
+
+    // Image consumed
+    lsu_write_32(SOC_I3CCSR_I3C_EC_SECFWRECOVERYIF_RECOVERY_STATUS, 0x03);
+
+    SEND_STDOUT_CTRL(0x88);
+    VPRINTF(LOW, "bytes,ctrl_to_first,first_to_last,total,checksum\n");
+    VPRINTF(LOW, "%d,%d,%d,%d,%x\n", image_words * 4, t_first - t_ctrl, t_end - t_first,
+            t_end - t_ctrl, sum);
+    SEND_STDOUT_CTRL(0x89);
+
+    SEND_STDOUT_CTRL(0xff);
+}
@@ -128,5 +128,38 @@
 #define VEER_INTR_PRIO_SOC_IFC_ERROR    8
 #define VEER_INTR_PRIO_SOC_IFC_NOTIF    7
 
+// Single source of truth for the VeeR PIC programming and vectored ISRs in
+// caliptra_isr.c. Each entry pairs VEER_INTR_VEC_<NAME> and VEER_INTR_PRIO_<NAME>
+// with a handler and a PIC enable:
+//   X(NAME, handler, implemented, enable)
+//     NAME        - suffix of the VEER_INTR_VEC_* / VEER_INTR_PRIO_* defines
+//     handler     - expands to nonstd_veer_isr_<handler> / service_<handler>_intr
+//     implemented - 1: lay down the ISR, 0: route to std_rv_nop_machine (saves code space)
+//     enable      - value written to MEIE for this source
+// Vectors not listed here are left at priority 0 (never interrupt) and disabled.
+#define VEER_INTR_TABLE(X)                         \
+    X(DOE_ERROR,        doe_error,        1, 1)    \
+    X(DOE_NOTIF,        doe_notif,        1, 1)    \
+    X(ECC_ERROR,        ecc_error,        1, 1)    \
+    X(ECC_NOTIF,        ecc_notif,        1, 1)    \
+    X(HMAC_ERROR,       hmac_error,       1, 1)    \
+    X(HMAC_NOTIF,       hmac_notif,       1, 1)    \
+    X(KV_ERROR,         kv_error,         1, 1)    \
+    X(KV_NOTIF,         kv_notif,         1, 1)    \
+    X(SHA512_ERROR,     sha512_error,     1, 1)    \
+    X(SHA512_NOTIF,     sha512_notif,     1, 1)    \
+    X(SHA256_ERROR,     sha256_error,     1, 1)    \
+    X(SHA256_NOTIF,     sha256_notif,     1, 1)    \
+    X(QSPI_ERROR,       qspi_error,       0, 1)    \
+    X(QSPI_NOTIF,       qspi_notif,       0, 1)    \
+    X(UART_ERROR,       uart_error,       0, 1)    \
+    X(UART_NOTIF,       uart_notif,       0, 1)    \
+    X(I3C_ERROR,        i3c_error,        0, 1)    \
+    X(I3C_NOTIF,        i3c_notif,        0, 1)    \
+    X(SOC_IFC_ERROR,    soc_ifc_error,    1, 1)    \
+    X(SOC_IFC_NOTIF,    soc_ifc_notif,    1, 1)    \
+    X(SHA512_ACC_ERROR, sha512_acc_error, 1, 1)    \
+    X(SHA512_ACC_NOTIF, sha512_acc_notif, 1, 1)
+
 
 #endif // CALIPTRA_DEFINES_H
@@ -54,63 +54,14 @@ void nonstd_veer_mtvec_mcei(void) __attribute__ ((interrupt ("machine") , aligne
 
 
 // VeeR Per-Source Vectored ISR functions
-static void nonstd_veer_isr_doe_error     (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_doe_notif     (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_ecc_error     (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_ecc_notif     (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_hmac_error    (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_hmac_notif    (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_kv_error      (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_kv_notif      (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_sha512_error  (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_sha512_notif  (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_sha256_error  (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_sha256_notif  (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_qspi_error    (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_qspi_notif    (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_uart_error    (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_uart_notif    (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_i3c_error     (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_i3c_notif     (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_soc_ifc_error (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_soc_ifc_notif (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_sha512_acc_error (void) __attribute__ ((interrupt ("machine")));
-static void nonstd_veer_isr_sha512_acc_notif (void) __attribute__ ((interrupt ("machine")));
-
-// Could be much more fancy with C preprocessing to pair up the ISR with Vector
-// numbers as defined in caliptra_defines.h.... TODO
-static void          nonstd_veer_isr_0   (void) __attribute__ ((interrupt ("machine"))); // Empty function instead of function pointer for Vec 0
-static void (* const nonstd_veer_isr_1 ) (void) = nonstd_veer_isr_doe_error   ;    // -------.
-static void (* const nonstd_veer_isr_2 ) (void) = nonstd_veer_isr_doe_notif   ;    //        |
-static void (* const nonstd_veer_isr_3 ) (void) = nonstd_veer_isr_ecc_error   ;    //        |
-static void (* const nonstd_veer_isr_4 ) (void) = nonstd_veer_isr_ecc_notif   ;    //        |
-static void (* const nonstd_veer_isr_5 ) (void) = nonstd_veer_isr_hmac_error  ;    //        |
-static void (* const nonstd_veer_isr_6 ) (void) = nonstd_veer_isr_hmac_notif  ;    //        |
-static void (* const nonstd_veer_isr_7 ) (void) = nonstd_veer_isr_kv_error    ;    //        |
-static void (* const nonstd_veer_isr_8 ) (void) = nonstd_veer_isr_kv_notif    ;    //        |
-static void (* const nonstd_veer_isr_9 ) (void) = nonstd_veer_isr_sha512_error;    // Definitions come
-static void (* const nonstd_veer_isr_10) (void) = nonstd_veer_isr_sha512_notif;    // from the param'd
-static void (* const nonstd_veer_isr_11) (void) = nonstd_veer_isr_sha256_error;    // macro "nonstd_veer_isr"
-static void (* const nonstd_veer_isr_12) (void) = nonstd_veer_isr_sha256_notif;    // below
-static void (* const nonstd_veer_isr_13) (void) = std_rv_nop_machine          ;    //        |    nonstd_veer_isr_qspi_error ---.
-static void (* const nonstd_veer_isr_14) (void) = std_rv_nop_machine          ;    //        |    nonstd_veer_isr_qspi_notif    |
-static void (* const nonstd_veer_isr_15) (void) = std_rv_nop_machine          ;    //        |    nonstd_veer_isr_uart_error    | Unimplemented to
-static void (* const nonstd_veer_isr_16) (void) = std_rv_nop_machine          ;    //        |    nonstd_veer_isr_uart_notif    | save code space
-static void (* const nonstd_veer_isr_17) (void) = std_rv_nop_machine          ;    //        |    nonstd_veer_isr_i3c_error     |
-static void (* const nonstd_veer_isr_18) (void) = std_rv_nop_machine          ;    //        |    nonstd_veer_isr_i3c_notif  ---'
-static void (* const nonstd_veer_isr_19) (void) = nonstd_veer_isr_soc_ifc_error;   //        |
-static void (* const nonstd_veer_isr_20) (void) = nonstd_veer_isr_soc_ifc_notif;   //        |
-static void (* const nonstd_veer_isr_21) (void) = nonstd_veer_isr_sha512_acc_error;//        |
-static void (* const nonstd_veer_isr_22) (void) = nonstd_veer_isr_sha512_acc_notif;// -------'
-static void (* const nonstd_veer_isr_23) (void) = std_rv_nop_machine; // --------|
-static void (* const nonstd_veer_isr_24) (void) = std_rv_nop_machine; //         |
-static void (* const nonstd_veer_isr_25) (void) = std_rv_nop_machine; //         |
-static void (* const nonstd_veer_isr_26) (void) = std_rv_nop_machine; // Unimplemented ISR
-static void (* const nonstd_veer_isr_27) (void) = std_rv_nop_machine; //         |
-static void (* const nonstd_veer_isr_28) (void) = std_rv_nop_machine; //         |
-static void (* const nonstd_veer_isr_29) (void) = std_rv_nop_machine; //         |
-static void (* const nonstd_veer_isr_30) (void) = std_rv_nop_machine; //         |
-static void (* const nonstd_veer_isr_31) (void) = std_rv_nop_machine; // --------'
+// Expanded from VEER_INTR_TABLE (caliptra_defines.h); unimplemented sources
+// are omitted here and route to std_rv_nop_machine in the vector table.
+#define nonstd_veer_isr_decl_0(name)
+#define nonstd_veer_isr_decl_1(name) static void nonstd_veer_isr_##name (void) __attribute__ ((interrupt ("machine")));
+#define nonstd_veer_isr_decl(NAME, name, impl, en) nonstd_veer_isr_decl_##impl(name)
+VEER_INTR_TABLE(nonstd_veer_isr_decl)
+
+static void nonstd_veer_isr_0 (void) __attribute__ ((interrupt ("machine"))); // Empty function instead of function pointer for Vec 0
 
 // Table defines the VeeR non-standard vectored entries as an array of
 // function pointers.
@@ -121,41 +72,34 @@ static void (* const nonstd_veer_isr_31) (void) = std_rv_nop_machine; // -------
 // be 4-byte aligned per the VeeR PRM, and the base address of the table (i.e.
 // the value of meivt) must be 1024-byte aligned, also per the PRM
 // For support of Fast Interrupt Redirect feature, this should be in DCCM
+// Every vector defaults to std_rv_nop_machine; sources from VEER_INTR_TABLE
+// override their own slot.
+#define nonstd_veer_isr_handler_0(name) std_rv_nop_machine
+#define nonstd_veer_isr_handler_1(name) nonstd_veer_isr_##name
+#define nonstd_veer_isr_vector(NAME, name, impl, en) [VEER_INTR_VEC_##NAME] = nonstd_veer_isr_handler_##impl(name),
 static void (* __attribute__ ((aligned(4))) nonstd_veer_isr_vector_table [MCU_RV_PIC_TOTAL_INT_PLUS1]) (void) __attribute__ ((aligned(1024),section (".dccm.nonstd_isr.vec_table"))) = {
-    nonstd_veer_isr_0,
-    nonstd_veer_isr_1,
-    nonstd_veer_isr_2,
-    nonstd_veer_isr_3,
-    nonstd_veer_isr_4,
-    nonstd_veer_isr_5,
-    nonstd_veer_isr_6,
-    nonstd_veer_isr_7,
-    nonstd_veer_isr_8,
-    nonstd_veer_isr_9,
-    nonstd_veer_isr_10,
-    nonstd_veer_isr_11,
-    nonstd_veer_isr_12,
-    nonstd_veer_isr_13,
-    nonstd_veer_isr_14,
-    nonstd_veer_isr_15,
-    nonstd_veer_isr_16,
-    nonstd_veer_isr_17,
-    nonstd_veer_isr_18,
-    nonstd_veer_isr_19,
-    nonstd_veer_isr_20,
-    nonstd_veer_isr_21,
-    nonstd_veer_isr_22,
-    nonstd_veer_isr_23,
-    nonstd_veer_isr_24,
-    nonstd_veer_isr_25,
-    nonstd_veer_isr_26,
-    nonstd_veer_isr_27,
-    nonstd_veer_isr_28,
-    nonstd_veer_isr_29,
-    nonstd_veer_isr_30,
-    nonstd_veer_isr_31
+    [0 ... MCU_RV_PIC_TOTAL_INT] = std_rv_nop_machine,
+    [0] = nonstd_veer_isr_0,
+    VEER_INTR_TABLE(nonstd_veer_isr_vector)
+};
+
+// PIC programming for each vector, consumed by init_interrupts()
+// Vectors not present in VEER_INTR_TABLE stay zero: priority 0 (never
+// interrupt) and disabled
+typedef struct {
+    uint8_t prio;
+    uint8_t en;
+} veer_intr_cfg_t;
+#define veer_intr_cfg_entry(NAME, name, impl, en) [VEER_INTR_VEC_##NAME] = { VEER_INTR_PRIO_##NAME, en },
+static const veer_intr_cfg_t veer_intr_cfg [MCU_RV_PIC_TOTAL_INT_PLUS1] = {
+    VEER_INTR_TABLE(veer_intr_cfg_entry)
 };
 
+// Per-source dispatch counters, indexed by PIC vector
+// Cleared by init_interrupts() and incremented on entry to each vectored ISR,
+// so tests can check exactly which sources were serviced (and how often)
+volatile uint32_t nonstd_veer_isr_count [MCU_RV_PIC_TOTAL_INT_PLUS1];
+
 // Table defines the RV standard vectored entries pointed to by mtvec
 // The entries in this table are entered depending on mcause
 // I.e. Exceptions and External Interrupts route to entries of this table
@@ -209,7 +153,6 @@ void init_interrupts(void) {
     // MPICCFG
     *mpiccfg = 0x0; // 0x0 - Standard compliant priority order: 0=lowest,15=highest
                     // 0x1 - Reverse priority order: 0=highest,15=lowest
-    __asm__ volatile ("fence");
 
     // MEIPT - No interrupts masked
     __asm__ volatile ("csrwi    %0, %1" \
@@ -217,33 +160,6 @@ void init_interrupts(void) {
                       : "i" (VEER_CSR_MEIPT), "i" (0x00)  /* input : immediate  */ \
                       : /* clobbers: none */);
 
-    // MEIPL_S - assign interrupt priorities
-    meipls[VEER_INTR_VEC_DOE_ERROR       ] = VEER_INTR_PRIO_DOE_ERROR       ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_DOE_NOTIF       ] = VEER_INTR_PRIO_DOE_NOTIF       ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_ECC_ERROR       ] = VEER_INTR_PRIO_ECC_ERROR       ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_ECC_NOTIF       ] = VEER_INTR_PRIO_ECC_NOTIF       ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_HMAC_ERROR      ] = VEER_INTR_PRIO_HMAC_ERROR      ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_HMAC_NOTIF      ] = VEER_INTR_PRIO_HMAC_NOTIF      ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_KV_ERROR        ] = VEER_INTR_PRIO_KV_ERROR        ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_KV_NOTIF        ] = VEER_INTR_PRIO_KV_NOTIF        ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_SHA512_ERROR    ] = VEER_INTR_PRIO_SHA512_ERROR    ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_SHA512_NOTIF    ] = VEER_INTR_PRIO_SHA512_NOTIF    ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_SHA256_ERROR    ] = VEER_INTR_PRIO_SHA256_ERROR    ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_SHA256_NOTIF    ] = VEER_INTR_PRIO_SHA256_NOTIF    ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_QSPI_ERROR      ] = VEER_INTR_PRIO_QSPI_ERROR      ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_QSPI_NOTIF      ] = VEER_INTR_PRIO_QSPI_NOTIF      ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_UART_ERROR      ] = VEER_INTR_PRIO_UART_ERROR      ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_UART_NOTIF      ] = VEER_INTR_PRIO_UART_NOTIF      ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_I3C_ERROR       ] = VEER_INTR_PRIO_I3C_ERROR       ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_I3C_NOTIF       ] = VEER_INTR_PRIO_I3C_NOTIF       ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_SOC_IFC_ERROR   ] = VEER_INTR_PRIO_SOC_IFC_ERROR   ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_SOC_IFC_NOTIF   ] = VEER_INTR_PRIO_SOC_IFC_NOTIF   ; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_SHA512_ACC_ERROR] = VEER_INTR_PRIO_SHA512_ACC_ERROR; __asm__ volatile ("fence");
-    meipls[VEER_INTR_VEC_SHA512_ACC_NOTIF] = VEER_INTR_PRIO_SHA512_ACC_NOTIF; __asm__ volatile ("fence");
-    for (uint8_t undef = VEER_INTR_VEC_MAX_ASSIGNED+1; undef <= MCU_RV_PIC_TOTAL_INT; undef++) {
-        meipls[undef] = 0; __asm__ volatile ("fence"); // Set to 0 meaning NEVER interrupt
-    }
-
     // MEICIDPL - Initialize the Claim ID priority level to 0
     //            to allow nesting interrupts (Per PRM 6.5.1)
     __asm__ volatile ("csrwi    %0, %1" \
@@ -258,17 +174,27 @@ void init_interrupts(void) {
                       : "i" (VEER_CSR_MEICURPL), "i" (0x00)  /* input : immediate  */ \
                       : /* clobbers: none */);
 
+    // Program every PIC source from veer_intr_cfg (see VEER_INTR_TABLE)
+    // Global interrupts are disabled until the end of this routine, so the
+    // PIC writes need not be ordered individually; a single fence after the
+    // loop makes the whole configuration visible before any enable below.
     for (uint8_t vec = 1; vec <= MCU_RV_PIC_TOTAL_INT; vec++) {
+        // MEIPL_S - assign interrupt priorities (0 means NEVER interrupt)
+        meipls[vec]     = veer_intr_cfg[vec].prio;
+
         // MEIGWCTRL_S
-        meigwctrls[vec] = VEER_MEIGWCTRL_ACTIVE_HI_LEVEL;  __asm__ volatile ("fence");
+        meigwctrls[vec] = VEER_MEIGWCTRL_ACTIVE_HI_LEVEL;
 
         // MEIGWCLRS - Ensure all pending bits are clear in the gateway
         //             NOTE: Any write value clears the pending bit
-        meigwclrs[vec]  = 0; __asm__ volatile ("fence");
+        meigwclrs[vec]  = 0;
 
         // MEIE_S - Enable implemented interrupt sources
-        meies[vec]  = (vec <= VEER_INTR_VEC_MAX_ASSIGNED); __asm__ volatile ("fence");
+        meies[vec]      = veer_intr_cfg[vec].en;
+
+        nonstd_veer_isr_count[vec] = 0;
     }
+    __asm__ volatile ("fence");
 
     /* -- Re-enable global interrupts -- */
 
@@ -642,7 +568,7 @@ static void nonstd_veer_isr_0 (void) {
 // context switches (which is critical in an ISR) relative to regular function
 // calls
 #define stringify(text) #text
-#define nonstd_veer_isr(name) static void nonstd_veer_isr_##name (void) {                           \
+#define nonstd_veer_isr(NAME, name) static void nonstd_veer_isr_##name (void) {                     \
     SEND_STDOUT_CTRL(0xfb); /*FIXME*/                                                                 \
                                                                                                       \
     /* Print msg before enabling nested interrupts so it                                              \
@@ -679,6 +605,7 @@ static void nonstd_veer_isr_0 (void) {
                                                                                                       \
     /* Service the interrupt (clear the interrupt source) */                                          \
     intr_count++;                                                                                     \
+    nonstd_veer_isr_count[VEER_INTR_VEC_##NAME]++;                                                    \
     VPRINTF(MEDIUM,"cnt_"stringify(name)":%x\n",intr_count);                                          \
     /* Fill in with macro contents, e.g. "service_soc_ifc_error_intr" */                              \
     /* This will match one macro from this list:                                                      \
@@ -725,53 +652,10 @@ static void nonstd_veer_isr_0 (void) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// Auto define ISR for each interrupt source using a macro
+// Auto define ISR for each implemented interrupt source in VEER_INTR_TABLE
 // Resulting defined functions are, e.g. "nonstd_veer_isr_doe_error" (for Vector 1)
-
-// Non-Standard Vectored Interrupt Handler (DOE Error = Vector 1)
-nonstd_veer_isr(doe_error)
-// Non-Standard Vectored Interrupt Handler (DOE Notification = vector 2)
-nonstd_veer_isr(doe_notif)
-// Non-Standard Vectored Interrupt Handler (ECC Error = vector 3)
-nonstd_veer_isr(ecc_error)
-// Non-Standard Vectored Interrupt Handler (ECC Notification = vector 4)
-nonstd_veer_isr(ecc_notif)
-// Non-Standard Vectored Interrupt Handler (HMAC Error = vector 5)
-nonstd_veer_isr(hmac_error)
-// Non-Standard Vectored Interrupt Handler (HMAC Notification = vector 6)
-nonstd_veer_isr(hmac_notif)
-// Non-Standard Vectored Interrupt Handler (KeyVault Error = vector 7)
-nonstd_veer_isr(kv_error)
-// Non-Standard Vectored Interrupt Handler (KeyVault Notification = vector 8)
-nonstd_veer_isr(kv_notif)
-// Non-Standard Vectored Interrupt Handler (SHA512 Error = vector 9)
-nonstd_veer_isr(sha512_error)
-// Non-Standard Vectored Interrupt Handler (SHA512 Notification = vector 10)
-nonstd_veer_isr(sha512_notif)
-// Non-Standard Vectored Interrupt Handler (SHA256 Error = vector 11)
-nonstd_veer_isr(sha256_error)
-// Non-Standard Vectored Interrupt Handler (SHA256 Notification = vector 12)
-nonstd_veer_isr(sha256_notif)
-/********************** Save FW image space by omitting these unused ISR ******
- * // Non-Standard Vectored Interrupt Handler (QSPI Error = vector 13)          //
- * nonstd_veer_isr(qspi_error)                                                  //
- * // Non-Standard Vectored Interrupt Handler (QSPI Notification = vector 14)   //
- * nonstd_veer_isr(qspi_notif)                                                  //
- * // Non-Standard Vectored Interrupt Handler (UART Error = vector 15)          //
- * nonstd_veer_isr(uart_error)                                                  //
- * // Non-Standard Vectored Interrupt Handler (UART Notification = vector 16)   //
- * nonstd_veer_isr(uart_notif)                                                  //
- * // Non-Standard Vectored Interrupt Handler (I3C Error = vector 17)           //
- * nonstd_veer_isr(i3c_error)                                                   //
- * // Non-Standard Vectored Interrupt Handler (I3C Notification = vector 18)    //
- * nonstd_veer_isr(i3c_notif)                                                   //
-******************************************************************************/
-// Non-Standard Vectored Interrupt Handler (SOC_IFC Error = vector 19)
-nonstd_veer_isr(soc_ifc_error)
-// Non-Standard Vectored Interrupt Handler (SOC_IFC Notification = vector 20)
-nonstd_veer_isr(soc_ifc_notif)
-// Non-Standard Vectored Interrupt Handler (SHA Error = vector 21)
-nonstd_veer_isr(sha512_acc_error)
-// Non-Standard Vectored Interrupt Handler (SHA Notification = vector 22)
-nonstd_veer_isr(sha512_acc_notif)
-
+// Sources marked unimplemented (QSPI, UART, I3C) are omitted to save FW image space
+#define nonstd_veer_isr_impl_0(NAME, name)
+#define nonstd_veer_isr_impl_1(NAME, name) nonstd_veer_isr(NAME, name)
+#define nonstd_veer_isr_impl(NAME, name, impl, en) nonstd_veer_isr_impl_##impl(NAME, name)
+VEER_INTR_TABLE(nonstd_veer_isr_impl)
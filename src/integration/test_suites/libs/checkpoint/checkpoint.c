@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "checkpoint.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CHECKPOINT_LOG "checkpoint_run.log"
+
+struct ckpt_test {
+  char *dir;
+  pid_t pid;
+  int status;
+  double start;
+  double secs;
+};
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int read_list(const char *list, struct ckpt_test **tests) {
+  FILE *fp;
+  char line[4096];
+  int n = 0, cap = 0;
+
+  fp = fopen(list, "r");
+  if (!fp) {
+    fprintf(stderr, "checkpoint: Unable to open %s: %s (%d)\n", list,
+            strerror(errno), errno);
+    return -1;
+  }
+  *tests = NULL;
+  while (fgets(line, sizeof(line), fp)) {
+    char *s = line, *e;
+
+    if ((e = strchr(s, '#'))) {
+      *e = '\0';
+    }
+    while (*s == ' ' || *s == '\t') {
+      s++;
+    }
+    e = s + strlen(s);
+    while (e > s && (e[-1] == '\n' || e[-1] == '\r' || e[-1] == ' ' ||
+                     e[-1] == '\t')) {
+      *--e = '\0';
+    }
+    if (!*s) {
+      continue;
+    }
+    if (n == cap) {
+      cap = cap ? 2 * cap : 16;
+      *tests = (struct ckpt_test *)realloc(*tests, cap * sizeof(**tests));
+    }
+    memset(&(*tests)[n], 0, sizeof(**tests));
+    (*tests)[n++].dir = strdup(s);
+  }
+  fclose(fp);
+  return n;
+}
+
+// Child side: continue the simulation inside the test directory
+static int enter_test(const struct ckpt_test *t) {
+  int fd;
+
+  if (chdir(t->dir) != 0) {
+    fprintf(stderr, "checkpoint: Unable to enter %s: %s (%d)\n", t->dir,
+            strerror(errno), errno);
+    _exit(2);
+  }
+  fd = open(CHECKPOINT_LOG, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    fprintf(stderr, "checkpoint: Unable to create %s/%s: %s (%d)\n", t->dir,
+            CHECKPOINT_LOG, strerror(errno), errno);
+    _exit(2);
+  }
+  dup2(fd, STDOUT_FILENO);
+  dup2(fd, STDERR_FILENO);
+  close(fd);
+  setvbuf(stdout, NULL, _IOLBF, 0);
+  return 1;
+}
+
+// A test passed if it exited cleanly and the TB reported TESTCASE PASSED
+static int test_passed(const struct ckpt_test *t) {
+  char path[4096], line[1024];
+  FILE *fp;
+  int passed = 0;
+
+  if (!WIFEXITED(t->status) || WEXITSTATUS(t->status) != 0) {
+    return 0;
+  }
+  snprintf(path, sizeof(path), "%s/%s", t->dir, CHECKPOINT_LOG);
+  fp = fopen(path, "r");
+  if (!fp) {
+    return 0;
+  }
+  while (!passed && fgets(line, sizeof(line), fp)) {
+    passed = strstr(line, "* TESTCASE PASSED") != NULL;
+  }
+  fclose(fp);
+  return passed;
+}
+
+int checkpoint_fork(const char *list, int jobs) {
+  struct ckpt_test *tests;
+  int n, next = 0, running = 0, failed = 0;
+  double t0 = now();
+
+  n = read_list(list, &tests);
+  if (n <= 0) {
+    if (n == 0) {
+      fprintf(stderr, "checkpoint: %s lists no tests\n", list);
+    }
+    return -1;
+  }
+  if (jobs < 1) {
+    jobs = 1;
+  }
+  printf("checkpoint: running %d test(s) from checkpoint, %d job(s)\n", n,
+         jobs);
+
+  while (next < n || running) {
+    pid_t pid;
+    int status;
+
+    while (next < n && running < jobs) {
+      struct ckpt_test *t = &tests[next];
+
+      // Buffered output would otherwise be written once per child
+      fflush(NULL);
+      pid = fork();
+      if (pid < 0) {
+        fprintf(stderr, "checkpoint: fork failed: %s (%d)\n", strerror(errno),
+                errno);
+        t->status = -1;
+        next++;
+        continue;
+      }
+      if (pid == 0) {
+        return enter_test(t);
+      }
+      t->pid = pid;
+      t->start = now();
+      next++;
+      running++;
+    }
+    if (!running) {
+      break;
+    }
+    pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    for (int i = 0; i < n; i++) {
+      if (tests[i].pid == pid) {
+        tests[i].status = status;
+        tests[i].secs = now() - tests[i].start;
+        running--;
+        printf("checkpoint: %-40s %s %8.1fs\n", tests[i].dir,
+               test_passed(&tests[i]) ? "PASS" : "FAIL", tests[i].secs);
+        fflush(stdout);
+        break;
+      }
+    }
+  }
+
+  printf("\ncheckpoint: summary\n");
+  for (int i = 0; i < n; i++) {
+    int pass = tests[i].pid > 0 && test_passed(&tests[i]);
+    failed += !pass;
+    printf("  %-40s %s\n", tests[i].dir, pass ? "PASS" : "FAIL");
+    free(tests[i].dir);
+  }
+  printf("checkpoint: %d/%d passed in %.1fs\n", n - failed, n, now() - t0);
+  fflush(NULL);
+  free(tests);
+  return failed ? 2 : 0;
+}
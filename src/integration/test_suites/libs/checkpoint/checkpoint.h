@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_CHECKPOINT_H_
+#define CALIPTRA_SS_CHECKPOINT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Checkpoint the simulation and run the listed tests from it
+ *
+ * Call from the simulator thread at the checkpoint milestone. The process is
+ * forked once per test directory in the list file, up to jobs children at a
+ * time. Each child changes into its test directory, redirects stdout/stderr
+ * to checkpoint_run.log there and returns 1, continuing the simulation with
+ * the full model state of the checkpoint.
+ *
+ * The calling (checkpoint) process waits for all children, prints a summary
+ * and returns; the TB then reports the result and ends it with $finish, so
+ * its final blocks still run.
+ *
+ * The model must be single threaded at this point: simulator worker threads
+ * and DPI helper threads are not duplicated by fork().
+ *
+ * @param list  file with one test directory per line, '#' starts a comment
+ * @param jobs  number of tests to run in parallel
+ * @return 1 in a child; in the checkpoint process 0 if every test passed,
+ *         2 if any failed, -1 if the list cannot be used (no fork happened)
+ */
+int checkpoint_fork(const char *list, int jobs);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_CHECKPOINT_H_
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Post-boot checkpoint
+//
+// DPI import for checkpoint.c. The simulation is forked at the checkpoint
+// milestone, once per test directory, so every test continues from the
+// booted model state.
+
+package checkpoint_pkg;
+
+  // Returns 1 in each forked test, -1 on error. The checkpoint process returns
+  // once all tests have finished: 0 if all passed, 2 otherwise.
+  import "DPI-C"
+  function int checkpoint_fork(input string list, input int jobs);
+
+endpackage
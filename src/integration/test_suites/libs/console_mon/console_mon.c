@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "console_mon.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CONSOLE_BUF_SIZE  (1 << 20)
+#define EVENTS_BUF_SIZE   (1 << 16)
+// Longer lines are split, the console has no use for them
+#define LINE_MAX_CHARS    1024
+
+struct console_mon_ctx {
+  FILE *console;
+  FILE *events;
+  int flags;
+  char *console_buf;
+  char *events_buf;
+  // Line being assembled and the last completed one
+  char line[2][LINE_MAX_CHARS + 32];
+  int cur;
+  int len;
+};
+
+// STDOUT mailbox commands, see the console monitor in caliptra_ss_top_tb.sv
+static const char *event_name(unsigned int cmd) {
+  switch (cmd) {
+    case 0x01: return "test_failed";
+    case 0x80: return "ext_irq_clear";
+    case 0x81: return "ext_irq_set";
+    case 0x82: return "nmi_timer_irq_clear";
+    case 0x83: return "nmi_timer_irq_set";
+    case 0x84: return "isr_entry";
+    case 0x85: return "isr_exit";
+    case 0x86: return "boot_marker";
+    case 0x88: return "bench_csv_start";
+    case 0x89: return "bench_csv_stop";
+    case 0x8a: return "fw_exec_lock";
+    case 0x8b: return "checkpoint";
+    case 0x8c: return "mem_snapshot";
+    case 0x8d: return "i3c_recovery_start";
+    case 0x8e: return "wave_dump";
+    case 0x90: return "irq_clear_all";
+    case 0xe0: return "iccm_single_bit_error";
+    case 0xe1: return "iccm_double_bit_error";
+    case 0xe2: return "dccm_single_bit_error";
+    case 0xe3: return "dccm_double_bit_error";
+    case 0xe4: return "ecc_error_injection_off";
+    case 0xff: return "test_passed";
+    default:   return "unknown";
+  }
+}
+
+static FILE *open_buffered(const char *path, char **buf, size_t size) {
+  FILE *fp = fopen(path, "w");
+
+  if (!fp) {
+    fprintf(stderr, "console_mon: Unable to open %s: %s (%d)\n", path,
+            strerror(errno), errno);
+    return NULL;
+  }
+  *buf = (char *)malloc(size);
+  if (*buf) {
+    setvbuf(fp, *buf, _IOFBF, size);
+  }
+  return fp;
+}
+
+void *console_mon_open(const char *console_path, const char *events_path,
+                       int flags) {
+  struct console_mon_ctx *ctx;
+
+  ctx = (struct console_mon_ctx *)calloc(1, sizeof(struct console_mon_ctx));
+  if (!ctx) {
+    return NULL;
+  }
+  ctx->flags = flags;
+  ctx->console = open_buffered(console_path, &ctx->console_buf,
+                               CONSOLE_BUF_SIZE);
+  if (!ctx->console) {
+    console_mon_close(ctx);
+    return NULL;
+  }
+  if (events_path && *events_path) {
+    ctx->events = open_buffered(events_path, &ctx->events_buf,
+                                EVENTS_BUF_SIZE);
+    if (!ctx->events) {
+      console_mon_close(ctx);
+      return NULL;
+    }
+  }
+  return ctx;
+}
+
+int console_mon_putc(void *ctx_void, int cycle, unsigned char ch) {
+  struct console_mon_ctx *ctx = (struct console_mon_ctx *)ctx_void;
+  char *line;
+
+  if (!ctx) {
+    return 0;
+  }
+  line = ctx->line[ctx->cur];
+  if (ctx->len == 0 && (ctx->flags & CONSOLE_MON_PREFIX)) {
+    ctx->len = snprintf(line, 32, "[%10u] ", (unsigned)cycle);
+  }
+  line[ctx->len++] = (char)ch;
+  if (ch != '\n' && ctx->len < LINE_MAX_CHARS) {
+    return 0;
+  }
+
+  line[ctx->len] = '\0';
+  fwrite(line, 1, ctx->len, ctx->console);
+  if (ctx->flags & CONSOLE_MON_FLUSH) {
+    fflush(ctx->console);
+  }
+  ctx->cur ^= 1;
+  ctx->len = 0;
+  return 1;
+}
+
+const char *console_mon_line(void *ctx_void) {
+  struct console_mon_ctx *ctx = (struct console_mon_ctx *)ctx_void;
+
+  return ctx ? ctx->line[ctx->cur ^ 1] : "";
+}
+
+void console_mon_event(void *ctx_void, int cycle, unsigned int data) {
+  struct console_mon_ctx *ctx = (struct console_mon_ctx *)ctx_void;
+  unsigned int cmd = data & 0xff;
+
+  if (!ctx || !ctx->events) {
+    return;
+  }
+  fprintf(ctx->events,
+          "{\"cycle\": %u, \"cmd\": \"0x%02x\", \"event\": \"%s\", "
+          "\"arg\": %u, \"data\": \"0x%08x\"}\n",
+          (unsigned)cycle, cmd, event_name(cmd), data >> 8, data);
+  // End of test: nothing may be lost if the simulator exits abruptly
+  if (cmd == 0xff || cmd == 0x01) {
+    console_mon_flush(ctx);
+  }
+}
+
+void console_mon_flush(void *ctx_void) {
+  struct console_mon_ctx *ctx = (struct console_mon_ctx *)ctx_void;
+
+  if (!ctx) {
+    return;
+  }
+  if (ctx->console) {
+    fflush(ctx->console);
+  }
+  if (ctx->events) {
+    fflush(ctx->events);
+  }
+}
+
+void console_mon_close(void *ctx_void) {
+  struct console_mon_ctx *ctx = (struct console_mon_ctx *)ctx_void;
+
+  if (!ctx) {
+    return;
+  }
+  if (ctx->console) {
+    fwrite(ctx->line[ctx->cur], 1, ctx->len, ctx->console);
+    fclose(ctx->console);
+  }
+  if (ctx->events) {
+    fclose(ctx->events);
+  }
+  free(ctx->console_buf);
+  free(ctx->events_buf);
+  free(ctx);
+}
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_CONSOLE_MON_H_
+#define CALIPTRA_SS_CONSOLE_MON_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Console options, see console_mon_open() */
+#define CONSOLE_MON_PREFIX 0x1  // prefix each console line with the TB cycle
+#define CONSOLE_MON_FLUSH  0x2  // flush the console log after every line
+
+/**
+ * Open the console and event logs
+ *
+ * The console log is written through a large buffer and only flushed at the
+ * end of the test, on console_mon_flush(), or per line with
+ * CONSOLE_MON_FLUSH. The event log gets one JSON object per line for each
+ * STDOUT mailbox command byte.
+ *
+ * @param console_path console log, e.g. mcu_console.log
+ * @param events_path  event log, NULL or "" for none
+ * @param flags        CONSOLE_MON_* options
+ * @return handle, NULL on error
+ */
+void *console_mon_open(const char *console_path, const char *events_path,
+                       int flags);
+
+/**
+ * Add a console character
+ *
+ * @return 1 when ch completed a line, which console_mon_line() then returns
+ */
+int console_mon_putc(void *ctx, int cycle, unsigned char ch);
+
+/**
+ * The last completed console line, including the cycle prefix and newline.
+ * Valid until the next console_mon_putc().
+ */
+const char *console_mon_line(void *ctx);
+
+/** Log a STDOUT mailbox command (data[7:0] is the command byte) */
+void console_mon_event(void *ctx, int cycle, unsigned int data);
+
+/** Write out buffered console and event data */
+void console_mon_flush(void *ctx);
+
+/** Flush and close both logs; a pending partial line is written as is */
+void console_mon_close(void *ctx);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_CONSOLE_MON_H_
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// MCU console monitor
+//
+// DPI imports for console_mon.c. Console characters from the STDOUT mailbox
+// are collected into lines and written through a large buffer; mailbox
+// command bytes go to a JSON-lines event log.
+
+package console_mon_pkg;
+
+  localparam int CONSOLE_MON_PREFIX = 'h1; // prefix lines with the TB cycle
+  localparam int CONSOLE_MON_FLUSH  = 'h2; // flush the console log every line
+
+  import "DPI-C"
+  function chandle console_mon_open(input string console_path, input string events_path, input int flags);
+
+  // Returns 1 when ch completed a line, console_mon_line() then returns it
+  import "DPI-C"
+  function int console_mon_putc(input chandle ctx, input int cycle, input byte unsigned ch);
+
+  import "DPI-C"
+  function string console_mon_line(input chandle ctx);
+
+  import "DPI-C"
+  function void console_mon_event(input chandle ctx, input int cycle, input int unsigned data);
+
+  import "DPI-C"
+  function void console_mon_flush(input chandle ctx);
+
+  import "DPI-C"
+  function void console_mon_close(input chandle ctx);
+
+endpackage
@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Transaction level stand-in for the Caliptra core SoC interface
+//
+// Models what the SoC sees of the core through the AXI sub: the soc_ifc boot
+// FSM and flow status, the mailbox protocol and plain register storage for
+// the rest of soc_ifc and the SHA accelerator. There is no ROM and no
+// firmware; commands are answered after a fixed delay, echoing the request
+// data when a response is required.
+
+#include "cptra_tlm.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "soc_address_map.h"
+
+namespace {
+
+// soc_ifc.h of caliptra-rtl
+enum BootFsm : uint32_t {
+  BOOT_IDLE = 0,
+  BOOT_FUSE = 1,
+  BOOT_FW_RST = 2,
+  BOOT_WAIT = 3,
+  BOOT_DONE = 4
+};
+enum MboxStatus : uint32_t {
+  CMD_BUSY = 0,
+  DATA_READY = 1,
+  CMD_COMPLETE = 2,
+  CMD_FAILURE = 3
+};
+enum MboxFsm : uint32_t {
+  MBOX_IDLE = 0,
+  MBOX_RDY_FOR_CMD = 1,
+  MBOX_RDY_FOR_DATA = 2,
+  MBOX_RDY_FOR_DLEN = 3,
+  MBOX_EXECUTE_SOC = 4,
+  MBOX_EXECUTE_UC = 6
+};
+
+constexpr uint32_t kMboxCmdRespMask = 0x40000000;  // MBOX_CMD_FIELD_RESP_MASK
+constexpr uint32_t kCmdFirmwareLoad = 0x46574C44;  // "FWLD"
+constexpr uint32_t kMboxWords = 256 * 1024 / 4;
+constexpr int kFwRstCycles = 16;
+
+bool in_range(uint32_t addr, uint32_t base, uint32_t size) {
+  return addr - base < size;
+}
+
+class CptraTlm {
+ public:
+  CptraTlm(int rom_cycles, int mbox_cycles, FILE *log)
+      : rom_cycles_(rom_cycles), mbox_cycles_(mbox_cycles), log_(log) {}
+  ~CptraTlm() {
+    if (log_) {
+      fclose(log_);
+    }
+  }
+
+  void reset(bool brkpoint);
+  int tick();
+  int write(uint32_t addr, uint32_t data, uint32_t strb, uint32_t user);
+  int read(uint32_t addr, uint32_t user, uint32_t *data);
+  uint32_t fw_exec_ctrl(int idx) const;
+  void report() const;
+
+ private:
+  uint32_t flow_status() const;
+  uint32_t mbox_status() const;
+  void mbox_release();
+  void mbox_respond();
+
+  const int rom_cycles_;
+  const int mbox_cycles_;
+  FILE *log_;
+  uint64_t cycle_ = 0;
+
+  std::unordered_map<uint32_t, uint32_t> regs_;
+
+  BootFsm boot_ = BOOT_IDLE;
+  bool brkpoint_ = false;
+  int boot_timer_ = 0;
+  bool ready_for_mb_ = false;
+  bool ready_for_rt_ = false;
+  uint64_t ready_cycle_ = 0;
+
+  bool lock_ = false;
+  uint32_t lock_user_ = 0;
+  MboxFsm mbox_ = MBOX_IDLE;
+  MboxStatus status_ = CMD_BUSY;
+  uint32_t cmd_ = 0;
+  uint32_t dlen_ = 0;
+  std::vector<uint32_t> data_;
+  uint32_t rdptr_ = 0;
+  int mbox_timer_ = 0;
+  uint64_t exec_cycle_ = 0;
+  unsigned ncmds_ = 0;
+};
+
+void CptraTlm::reset(bool brkpoint) {
+  regs_.clear();
+  brkpoint_ = brkpoint;
+  // The ROM would now wait for fuses
+  boot_ = BOOT_FUSE;
+  boot_timer_ = 0;
+  ready_for_mb_ = false;
+  ready_for_rt_ = false;
+  mbox_release();
+}
+
+int CptraTlm::tick() {
+  cycle_++;
+  if (boot_timer_ && !--boot_timer_) {
+    if (boot_ == BOOT_FW_RST) {
+      boot_ = BOOT_DONE;
+      boot_timer_ = rom_cycles_ > 0 ? rom_cycles_ : 1;
+    } else if (boot_ == BOOT_DONE) {
+      ready_for_mb_ = true;
+      ready_cycle_ = cycle_;
+    }
+  }
+  if (mbox_timer_ && !--mbox_timer_) {
+    mbox_respond();
+  }
+  return (boot_ == BOOT_FUSE ? CPTRA_TLM_READY_FOR_FUSES : 0) |
+         (ready_for_mb_ ? CPTRA_TLM_READY_FOR_MB_PROCESSING : 0) |
+         (ready_for_rt_ ? CPTRA_TLM_READY_FOR_RUNTIME : 0) |
+         (mbox_ == MBOX_EXECUTE_SOC ? CPTRA_TLM_MAILBOX_DATA_AVAIL : 0);
+}
+
+uint32_t CptraTlm::fw_exec_ctrl(int idx) const {
+  if (idx < 0 || idx > 3) {
+    return 0;
+  }
+  auto it = regs_.find(SOC_SOC_IFC_REG_SS_GENERIC_FW_EXEC_CTRL_0 + 4 * idx);
+  return it != regs_.end() ? it->second : 0;
+}
+
+uint32_t CptraTlm::flow_status() const {
+  return (regs_.count(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS)
+              ? regs_.at(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) &
+                    SOC_IFC_REG_CPTRA_FLOW_STATUS_STATUS_MASK
+              : 0) |
+         (boot_ << SOC_IFC_REG_CPTRA_FLOW_STATUS_BOOT_FSM_PS_LOW) |
+         (ready_for_mb_ ? SOC_IFC_REG_CPTRA_FLOW_STATUS_READY_FOR_MB_PROCESSING_MASK : 0) |
+         (ready_for_rt_ ? SOC_IFC_REG_CPTRA_FLOW_STATUS_READY_FOR_RUNTIME_MASK : 0) |
+         (boot_ == BOOT_FUSE ? SOC_IFC_REG_CPTRA_FLOW_STATUS_READY_FOR_FUSES_MASK : 0);
+}
+
+uint32_t CptraTlm::mbox_status() const {
+  return (status_ << MBOX_CSR_MBOX_STATUS_STATUS_LOW) |
+         (mbox_ << MBOX_CSR_MBOX_STATUS_MBOX_FSM_PS_LOW) |
+         (lock_ ? MBOX_CSR_MBOX_STATUS_SOC_HAS_LOCK_MASK : 0) |
+         ((rdptr_ << MBOX_CSR_MBOX_STATUS_MBOX_RDPTR_LOW) &
+          MBOX_CSR_MBOX_STATUS_MBOX_RDPTR_MASK);
+}
+
+void CptraTlm::mbox_release() {
+  lock_ = false;
+  mbox_ = MBOX_IDLE;
+  status_ = CMD_BUSY;
+  cmd_ = 0;
+  dlen_ = 0;
+  data_.clear();
+  rdptr_ = 0;
+  mbox_timer_ = 0;
+}
+
+// Stands in for the firmware: echo the request when a response is required
+void CptraTlm::mbox_respond() {
+  if (cmd_ & kMboxCmdRespMask) {
+    status_ = DATA_READY;
+  } else {
+    status_ = CMD_COMPLETE;
+    dlen_ = 0;
+  }
+  if (cmd_ == kCmdFirmwareLoad) {
+    ready_for_rt_ = true;
+  }
+  rdptr_ = 0;
+  mbox_ = MBOX_EXECUTE_SOC;
+  if (log_) {
+    fprintf(log_, "%llu %llu 0x%08x %u %s\n", (unsigned long long)exec_cycle_,
+            (unsigned long long)cycle_, cmd_, dlen_,
+            status_ == DATA_READY ? "data_ready" : "cmd_complete");
+  }
+}
+
+int CptraTlm::write(uint32_t addr, uint32_t data, uint32_t strb, uint32_t user) {
+  uint32_t mask = 0;
+
+  for (int i = 0; i < 4; i++) {
+    mask |= (strb >> i & 1) ? 0xffu << (8 * i) : 0;
+  }
+  if (in_range(addr, SOC_MBOX_CSR_BASE_ADDR, 0x1000)) {
+    if (!lock_ || user != lock_user_) {
+      return CPTRA_TLM_SLVERR;
+    }
+    switch (addr) {
+      case SOC_MBOX_CSR_MBOX_CMD:
+        if (mbox_ == MBOX_RDY_FOR_CMD) {
+          cmd_ = data;
+          mbox_ = MBOX_RDY_FOR_DLEN;
+        }
+        break;
+      case SOC_MBOX_CSR_MBOX_DLEN:
+        if (mbox_ == MBOX_RDY_FOR_DLEN || mbox_ == MBOX_RDY_FOR_DATA) {
+          dlen_ = data;
+          mbox_ = MBOX_RDY_FOR_DATA;
+        }
+        break;
+      case SOC_MBOX_CSR_MBOX_DATAIN:
+        if (mbox_ == MBOX_RDY_FOR_DATA && data_.size() < kMboxWords) {
+          data_.push_back(data);
+        }
+        break;
+      case SOC_MBOX_CSR_MBOX_EXECUTE:
+        if (data & MBOX_CSR_MBOX_EXECUTE_EXECUTE_MASK) {
+          if (mbox_ == MBOX_RDY_FOR_DATA) {
+            mbox_ = MBOX_EXECUTE_UC;
+            exec_cycle_ = cycle_;
+            mbox_timer_ = mbox_cycles_ > 0 ? mbox_cycles_ : 1;
+            ncmds_++;
+          }
+        } else {
+          mbox_release();
+        }
+        break;
+      default:
+        break;
+    }
+    return CPTRA_TLM_OKAY;
+  }
+  if (!in_range(addr, SOC_SHA512_ACC_CSR_BASE_ADDR, 0x1000) &&
+      !in_range(addr, SOC_SOC_IFC_REG_BASE_ADDR, 0x1000)) {
+    return CPTRA_TLM_SLVERR;
+  }
+  switch (addr) {
+    case SOC_SOC_IFC_REG_CPTRA_FUSE_WR_DONE:
+      if ((data & mask & SOC_IFC_REG_CPTRA_FUSE_WR_DONE_DONE_MASK) &&
+          boot_ == BOOT_FUSE) {
+        boot_ = brkpoint_ ? BOOT_WAIT : BOOT_FW_RST;
+        boot_timer_ = brkpoint_ ? 0 : kFwRstCycles;
+      }
+      break;
+    case SOC_SOC_IFC_REG_CPTRA_BOOTFSM_GO:
+      if ((data & mask & SOC_IFC_REG_CPTRA_BOOTFSM_GO_GO_MASK) &&
+          boot_ == BOOT_WAIT) {
+        boot_ = BOOT_FW_RST;
+        boot_timer_ = kFwRstCycles;
+      }
+      break;
+    default:
+      break;
+  }
+  uint32_t &r = regs_[addr];
+  r = (r & ~mask) | (data & mask);
+  return CPTRA_TLM_OKAY;
+}
+
+int CptraTlm::read(uint32_t addr, uint32_t user, uint32_t *data) {
+  *data = 0;
+  if (in_range(addr, SOC_MBOX_CSR_BASE_ADDR, 0x1000)) {
+    switch (addr) {
+      case SOC_MBOX_CSR_MBOX_LOCK:
+        // Read to acquire
+        *data = lock_;
+        if (!lock_) {
+          mbox_release();
+          lock_ = true;
+          lock_user_ = user;
+          mbox_ = MBOX_RDY_FOR_CMD;
+        }
+        break;
+      case SOC_MBOX_CSR_MBOX_USER: *data = lock_user_; break;
+      case SOC_MBOX_CSR_MBOX_CMD: *data = cmd_; break;
+      case SOC_MBOX_CSR_MBOX_DLEN: *data = dlen_; break;
+      case SOC_MBOX_CSR_MBOX_DATAOUT:
+        if (rdptr_ < data_.size()) {
+          *data = data_[rdptr_];
+        }
+        rdptr_++;
+        break;
+      case SOC_MBOX_CSR_MBOX_EXECUTE: *data = mbox_ == MBOX_EXECUTE_UC || mbox_ == MBOX_EXECUTE_SOC; break;
+      case SOC_MBOX_CSR_MBOX_STATUS: *data = mbox_status(); break;
+      default: break;
+    }
+    return CPTRA_TLM_OKAY;
+  }
+  if (addr == SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) {
+    *data = flow_status();
+    return CPTRA_TLM_OKAY;
+  }
+  if (!in_range(addr, SOC_SHA512_ACC_CSR_BASE_ADDR, 0x1000) &&
+      !in_range(addr, SOC_SOC_IFC_REG_BASE_ADDR, 0x1000)) {
+    return CPTRA_TLM_SLVERR;
+  }
+  auto it = regs_.find(addr);
+  if (it != regs_.end()) {
+    *data = it->second;
+  }
+  return CPTRA_TLM_OKAY;
+}
+
+void CptraTlm::report() const {
+  printf("cptra tlm: %u mailbox command(s)", ncmds_);
+  if (ready_for_mb_) {
+    printf(", ready_for_mb_processing at cycle %llu", (unsigned long long)ready_cycle_);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+
+}  // namespace
+
+void *cptra_tlm_open(int rom_cycles, int mbox_cycles, const char *log_path) {
+  FILE *log = nullptr;
+
+  if (log_path && *log_path) {
+    log = fopen(log_path, "w");
+    if (!log) {
+      fprintf(stderr, "cptra_tlm: Unable to open %s: %s (%d)\n", log_path,
+              strerror(errno), errno);
+      return nullptr;
+    }
+    fprintf(log, "# exec_cycle resp_cycle cmd dlen status\n");
+  }
+  return new CptraTlm(rom_cycles, mbox_cycles, log);
+}
+
+void cptra_tlm_reset(void *ctx, int brkpoint) {
+  if (ctx) {
+    static_cast<CptraTlm *>(ctx)->reset(brkpoint != 0);
+  }
+}
+
+int cptra_tlm_tick(void *ctx) {
+  return ctx ? static_cast<CptraTlm *>(ctx)->tick() : 0;
+}
+
+int cptra_tlm_write(void *ctx, unsigned int addr, unsigned int data,
+                    unsigned int strb, unsigned int user) {
+  return ctx ? static_cast<CptraTlm *>(ctx)->write(addr, data, strb, user)
+             : CPTRA_TLM_SLVERR;
+}
+
+int cptra_tlm_read(void *ctx, unsigned int addr, unsigned int user,
+                   unsigned int *data) {
+  if (!ctx) {
+    *data = 0;
+    return CPTRA_TLM_SLVERR;
+  }
+  return static_cast<CptraTlm *>(ctx)->read(addr, user, data);
+}
+
+unsigned int cptra_tlm_fw_exec_ctrl(void *ctx, int idx) {
+  return ctx ? static_cast<CptraTlm *>(ctx)->fw_exec_ctrl(idx) : 0;
+}
+
+void cptra_tlm_close(void *ctx) {
+  if (ctx) {
+    static_cast<CptraTlm *>(ctx)->report();
+    delete static_cast<CptraTlm *>(ctx);
+  }
+}
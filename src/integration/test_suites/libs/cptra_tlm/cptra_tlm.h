@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_CPTRA_TLM_H_
+#define CALIPTRA_SS_CPTRA_TLM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Outputs returned by cptra_tlm_tick() */
+#define CPTRA_TLM_READY_FOR_FUSES         0x1
+#define CPTRA_TLM_READY_FOR_MB_PROCESSING 0x2
+#define CPTRA_TLM_READY_FOR_RUNTIME       0x4
+#define CPTRA_TLM_MAILBOX_DATA_AVAIL      0x8
+
+/** AXI responses of cptra_tlm_read() and cptra_tlm_write() */
+#define CPTRA_TLM_OKAY   0
+#define CPTRA_TLM_SLVERR 2
+
+/**
+ * Create the transaction level model of the Caliptra core SoC interface
+ *
+ * @param rom_cycles  cycles from the end of the boot FSM to
+ *                    READY_FOR_MB_PROCESSING, standing in for the ROM
+ * @param mbox_cycles cycles from a mailbox EXECUTE to the response
+ * @param log_path    mailbox command log, NULL or "" for none
+ * @return handle, NULL on error
+ */
+void *cptra_tlm_open(int rom_cycles, int mbox_cycles, const char *log_path);
+
+/**
+ * Caliptra reset deasserted: clear all state and start the boot FSM
+ *
+ * @param brkpoint BootFSM_BrkPoint, wait for CPTRA_BOOTFSM_GO after fuses
+ */
+void cptra_tlm_reset(void *ctx, int brkpoint);
+
+/** Advance one clock, @return CPTRA_TLM_* output flags */
+int cptra_tlm_tick(void *ctx);
+
+/**
+ * SoC register write, one 32-bit beat
+ *
+ * @param addr SoC address, e.g. SOC_MBOX_CSR_MBOX_CMD
+ * @param strb byte enables
+ * @param user AXI user of the requester, checked against the mailbox lock
+ * @return CPTRA_TLM_OKAY or CPTRA_TLM_SLVERR
+ */
+int cptra_tlm_write(void *ctx, unsigned int addr, unsigned int data,
+                    unsigned int strb, unsigned int user);
+
+/** SoC register read, one 32-bit beat, @return CPTRA_TLM_OKAY or CPTRA_TLM_SLVERR */
+int cptra_tlm_read(void *ctx, unsigned int addr, unsigned int user,
+                   unsigned int *data);
+
+/**
+ * SS_GENERIC_FW_EXEC_CTRL[idx], idx 0..3. There is no runtime firmware to set
+ * these; SoC writes to the registers are kept and returned here instead.
+ */
+unsigned int cptra_tlm_fw_exec_ctrl(void *ctx, int idx);
+
+/** Print the command summary and free the model */
+void cptra_tlm_close(void *ctx);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_CPTRA_TLM_H_
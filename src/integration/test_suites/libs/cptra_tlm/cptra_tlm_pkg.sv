@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Transaction level Caliptra core stand-in
+//
+// DPI imports for cptra_tlm.cpp, used by caliptra_top_tlm.
+
+package cptra_tlm_pkg;
+
+  // cptra_tlm_tick() output flags
+  localparam int CPTRA_TLM_READY_FOR_FUSES         = 'h1;
+  localparam int CPTRA_TLM_READY_FOR_MB_PROCESSING = 'h2;
+  localparam int CPTRA_TLM_READY_FOR_RUNTIME       = 'h4;
+  localparam int CPTRA_TLM_MAILBOX_DATA_AVAIL      = 'h8;
+
+  import "DPI-C"
+  function chandle cptra_tlm_open(input int rom_cycles, input int mbox_cycles, input string log_path);
+
+  import "DPI-C"
+  function void cptra_tlm_reset(input chandle ctx, input int brkpoint);
+
+  import "DPI-C"
+  function int cptra_tlm_tick(input chandle ctx);
+
+  import "DPI-C"
+  function int cptra_tlm_write(input chandle ctx, input int unsigned addr, input int unsigned data,
+                               input int unsigned strb, input int unsigned user);
+
+  import "DPI-C"
+  function int cptra_tlm_read(input chandle ctx, input int unsigned addr, input int unsigned user,
+                              output int unsigned data);
+
+  import "DPI-C"
+  function int unsigned cptra_tlm_fw_exec_ctrl(input chandle ctx, input int idx);
+
+  import "DPI-C"
+  function void cptra_tlm_close(input chandle ctx);
+
+endpackage
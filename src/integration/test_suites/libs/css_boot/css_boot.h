@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef CSS_BOOT_H
+#define CSS_BOOT_H
+
+#include "soc_address_map.h"
+#include "riscv_hw_if.h"
+#include "soc_ifc.h"
+#include "printf.h"
+#include <stdint.h>
+
+// STDOUT of the test, see caliptra_ss_top_tb.sv for the commands
+extern volatile char* stdout;
+
+#define CSS_BOOT_TB_CMD_FW_EXEC_LOCK 0x8A
+
+// MCU restarted from the post-boot checkpoint (libs/checkpoint/README.md),
+// Caliptra is already at ready_for_mb_processing
+static inline int css_boot_resumed(void) {
+    return (lsu_read_32(SOC_MCI_REG_RESET_REASON) & MCI_REG_RESET_REASON_FW_BOOT_UPD_RESET_MASK) != 0;
+}
+
+// Brings Caliptra up to ready_for_mb_processing: BOOT_GO, fuse write done,
+// BootFSM breakpoint GO. After a checkpoint restart the boot is skipped and
+// only the exec region lock override of the checkpoint is released.
+// Returns 1 when the boot was skipped.
+static inline int css_cptra_boot(void) {
+    enum boot_fsm_state_e boot_fsm_ps;
+
+    if (css_boot_resumed()) {
+        VPRINTF(LOW, "MCU: restarted after checkpoint, Caliptra already booted\n");
+        lsu_write_32((uintptr_t) stdout, CSS_BOOT_TB_CMD_FW_EXEC_LOCK);
+        return 1;
+    }
+
+    // Writing to Caliptra Boot GO register of MCI for CSS BootFSM to bring Caliptra out of reset
+    lsu_write_32(SOC_MCI_REG_CALIPTRA_BOOT_GO, 1);
+    VPRINTF(LOW, "MCU: Writing MCI SOC_MCI_REG_CALIPTRA_BOOT_GO\n");
+
+    // Wait for ready_for_fuses
+    while(!(lsu_read_32(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) & SOC_IFC_REG_CPTRA_FLOW_STATUS_READY_FOR_FUSES_MASK));
+
+    // Initialize fuses
+    lsu_write_32(SOC_SOC_IFC_REG_CPTRA_FUSE_WR_DONE, SOC_IFC_REG_CPTRA_FUSE_WR_DONE_DONE_MASK);
+    VPRINTF(LOW, "MCU: Set fuse wr done\n");
+
+    // Wait for Boot FSM to stall (on breakpoint) or finish bootup
+    boot_fsm_ps = (lsu_read_32(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) & SOC_IFC_REG_CPTRA_FLOW_STATUS_BOOT_FSM_PS_MASK) >> SOC_IFC_REG_CPTRA_FLOW_STATUS_BOOT_FSM_PS_LOW;
+    while(boot_fsm_ps != BOOT_DONE && boot_fsm_ps != BOOT_WAIT) {
+        for (uint8_t ii = 0; ii < 16; ii++) {
+            __asm__ volatile ("nop"); // Sleep loop as "nop"
+        }
+        boot_fsm_ps = (lsu_read_32(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) & SOC_IFC_REG_CPTRA_FLOW_STATUS_BOOT_FSM_PS_MASK) >> SOC_IFC_REG_CPTRA_FLOW_STATUS_BOOT_FSM_PS_LOW;
+    }
+
+    // Advance from breakpoint, if set
+    if (boot_fsm_ps == BOOT_WAIT) {
+        lsu_write_32(SOC_SOC_IFC_REG_CPTRA_BOOTFSM_GO, SOC_IFC_REG_CPTRA_BOOTFSM_GO_GO_MASK);
+    }
+    VPRINTF(LOW, "MCU: Set BootFSM GO\n");
+
+    // Wait for ready_for_mb_processing
+    while(!(lsu_read_32(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) & SOC_IFC_REG_CPTRA_FLOW_STATUS_READY_FOR_MB_PROCESSING_MASK)) {
+        for (uint8_t ii = 0; ii < 16; ii++) {
+            __asm__ volatile ("nop"); // Sleep loop as "nop"
+        }
+    }
+    VPRINTF(LOW, "MCU: Ready for FW\n");
+    return 0;
+}
+
+#endif // CSS_BOOT_H
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ecc_preload.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sparse_mem.h"
+
+// Parity masks of check bits 0..5, see riscv_ecc32() in caliptra_ss_top_tb.sv.
+// Bit 6 is the overall parity of data and check bits 0..5.
+static const uint32_t ecc_mask[6] = {0x56aaad5b, 0x9b33366d, 0xe3c3c78e,
+                                     0x03fc07f0, 0x03fff800, 0xfc000000};
+
+// Check bits 0..5 are linear in the data, so they are the XOR of one table
+// entry per data byte
+static uint8_t ecc_tab[4][256];
+static int ecc_tab_init;
+
+static void init_tab(void) {
+  for (int b = 0; b < 4; b++) {
+    for (int v = 0; v < 256; v++) {
+      uint32_t d = (uint32_t)v << (8 * b);
+      uint8_t synd = 0;
+      for (int i = 0; i < 6; i++) {
+        synd |= (uint8_t)(__builtin_parity(d & ecc_mask[i]) << i);
+      }
+      ecc_tab[b][v] = synd;
+    }
+  }
+  ecc_tab_init = 1;
+}
+
+uint8_t ecc_preload_ecc32(uint32_t data) {
+  uint8_t synd;
+
+  if (!ecc_tab_init) {
+    init_tab();
+  }
+  synd = ecc_tab[0][data & 0xff] ^ ecc_tab[1][(data >> 8) & 0xff] ^
+         ecc_tab[2][(data >> 16) & 0xff] ^ ecc_tab[3][data >> 24];
+  synd |= (uint8_t)((__builtin_parity(data) ^ __builtin_parity(synd)) << 6);
+  return synd;
+}
+
+// [row][lane] byte preloader. ptr/esize describe its storage when the
+// simulator exposes it (svGetArrayPtr) with every dimension ascending: one
+// byte or one svLogicVecVal per element, rows and lanes in index order.
+// Otherwise ptr is NULL and bytes are read with svGetLogicArrElem2VecVal().
+struct src_mem {
+  svOpenArrayHandle h;
+  const uint8_t *ptr;
+  size_t esize;
+  int rows, lanes, row_lo, lane_lo;
+};
+
+static void src_open(struct src_mem *m, const svOpenArrayHandle src) {
+  long long bytes;
+  int size;
+
+  m->h = src;
+  m->rows = svSize(src, 1);
+  m->lanes = svSize(src, 2);
+  m->row_lo = svLow(src, 1);
+  m->lane_lo = svLow(src, 2);
+  m->ptr = (const uint8_t *)svGetArrayPtr(src);
+  m->esize = 0;
+  bytes = (long long)m->rows * m->lanes;
+  size = m->ptr ? svSizeOfArray(src) : -1;
+  for (int d = 1; d <= 2; d++) {
+    if (svLeft(src, d) > svRight(src, d)) {
+      size = -1;
+    }
+  }
+  if (size == bytes) {
+    m->esize = 1;
+  } else if (size == bytes * (long long)sizeof(svLogicVecVal)) {
+    m->esize = sizeof(svLogicVecVal);
+  } else {
+    m->ptr = NULL;
+  }
+}
+
+// Source word w, 0 past the end
+static uint32_t src_word(const struct src_mem *m, long long w) {
+  uint32_t data = 0;
+  svLogicVecVal v;
+
+  for (int i = 0; i < 4; i++) {
+    long long byte = w * 4 + i;
+    long long row = byte / m->lanes;
+    if (row >= m->rows) {
+      return 0;
+    }
+    if (m->esize == 1) {
+      v.aval = m->ptr[byte];
+      v.bval = 0;
+    } else if (m->esize) {
+      memcpy(&v, m->ptr + byte * m->esize, sizeof(v));
+    } else {
+      svGetLogicArrElem2VecVal(&v, m->h, m->row_lo + (int)row,
+                               m->lane_lo + (int)(byte % m->lanes));
+    }
+    data |= ((v.aval & ~v.bval) & 0xff) << (8 * i);
+  }
+  return data;
+}
+
+// Destination is an open array (2- or 4-state), or a sparse_mem with
+// dst == NULL
+static int preload(const svOpenArrayHandle src, int word_lo, int stride,
+                   int clear, const svOpenArrayHandle dst, int two_state,
+                   void *sparse, int words) {
+  struct src_mem sm;
+  int dst_lo = 0, written = 0;
+
+  if (svDimensions(src) != 2 || (dst && svDimensions(dst) != 1) ||
+      (!dst && !sparse) || stride <= 0) {
+    fprintf(stderr, "ecc_preload: bad source/destination array\n");
+    return -1;
+  }
+  if (!ecc_tab_init) {
+    init_tab();
+  }
+  src_open(&sm, src);
+  if (dst) {
+    dst_lo = svLow(dst, 1);
+    words = svSize(dst, 1);
+  } else if (clear) {
+    sparse_mem_clear(sparse);
+    clear = 0;
+  }
+
+  for (int i = 0; i < words; i++) {
+    uint32_t data = src_word(&sm, word_lo + (long long)i * stride);
+    if (data == 0 && !clear) {
+      continue;
+    }
+    // {ecc, data}: 39 bits over two 32-bit chunks
+    if (!dst) {
+      sparse_mem_write(sparse, i,
+                       ((uint64_t)ecc_preload_ecc32(data) << 32) | data);
+    } else if (two_state) {
+      svBitVecVal v[2] = {data, ecc_preload_ecc32(data)};
+      svPutBitArrElem1VecVal(dst, v, dst_lo + i);
+    } else {
+      svLogicVecVal v[2] = {{data, 0}, {ecc_preload_ecc32(data), 0}};
+      svPutLogicArrElem1VecVal(dst, v, dst_lo + i);
+    }
+    written++;
+  }
+  return written;
+}
+
+int ecc_preload_reg(const svOpenArrayHandle src, int word_lo, int stride,
+                    int clear, const svOpenArrayHandle dst) {
+  return preload(src, word_lo, stride, clear, dst, 0, NULL, 0);
+}
+
+int ecc_preload_bit(const svOpenArrayHandle src, int word_lo, int stride,
+                    int clear, const svOpenArrayHandle dst) {
+  return preload(src, word_lo, stride, clear, dst, 1, NULL, 0);
+}
+
+int ecc_preload_sparse(const svOpenArrayHandle src, int word_lo, int stride,
+                       int clear, void *dst, int words) {
+  return preload(src, word_lo, stride, clear, NULL, 0, dst, words);
+}
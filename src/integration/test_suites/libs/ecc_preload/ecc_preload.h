@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_ECC_PRELOAD_H_
+#define CALIPTRA_SS_ECC_PRELOAD_H_
+
+#include <stdint.h>
+#include <svdpi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * SEC-DED code of a 32-bit word, same as the TB riscv_ecc32() function
+ *
+ * @param data  data word
+ * @return 7-bit check code
+ */
+uint8_t ecc_preload_ecc32(uint32_t data);
+
+/**
+ * Fill an ECC protected memory from a byte preloader
+ *
+ * The source is a [row][byte lane] preloader array holding little endian
+ * 32-bit words back to back. Destination element i receives source word
+ * word_lo + i * stride as {ecc, data}, so a DCCM bank b of n interleaved banks
+ * is filled with word_lo = b, stride = n. Source words past the end of the
+ * preloader read as zero.
+ *
+ * Unless clear is set, zero words are skipped: the destination must already
+ * be zero, which is the case after init_css_mcu0_dccm() or a simulator's
+ * default zero init. Set clear to reload a memory that is in use. X/Z source
+ * bits read as zero.
+ *
+ * @param src      preloader array, logic [7:0] [rows][lanes]
+ * @param word_lo  first source word
+ * @param stride   source word step between destination elements
+ * @param clear    also write zero words
+ * @param dst      destination array, [38:0] elements
+ * @return number of words written
+ */
+int ecc_preload_reg(const svOpenArrayHandle src, int word_lo, int stride,
+                    int clear, const svOpenArrayHandle dst);
+
+/** Same as ecc_preload_reg(), for a 2-state (bit [38:0]) destination */
+int ecc_preload_bit(const svOpenArrayHandle src, int word_lo, int stride,
+                    int clear, const svOpenArrayHandle dst);
+
+/**
+ * Same as ecc_preload_reg(), into words 0..words-1 of a sparse_mem memory.
+ * With clear set the memory is emptied first, so zero words stay unallocated.
+ */
+int ecc_preload_sparse(const svOpenArrayHandle src, int word_lo, int stride,
+                       int clear, void *dst, int words);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_ECC_PRELOAD_H_
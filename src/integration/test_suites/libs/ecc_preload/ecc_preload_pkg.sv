@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// ECC memory preload
+//
+// DPI imports for ecc_preload.c. Each call fills one whole {ecc, data} memory
+// or DCCM bank from a byte preloader, computing the SEC-DED codes in C and
+// skipping zero words.
+
+package ecc_preload_pkg;
+
+  // Destination element i <= src word (word_lo + i * stride), returns words written.
+  // Zero words are only written with clear set.
+  import "DPI-C"
+  function int ecc_preload_reg(input logic [7:0] src[][], input int word_lo, input int stride,
+                               input int clear, inout logic [38:0] dst[]);
+
+  import "DPI-C"
+  function int ecc_preload_bit(input logic [7:0] src[][], input int word_lo, input int stride,
+                               input int clear, inout bit [38:0] dst[]);
+
+  // Into words 0..words-1 of a sparse_mem memory (TB_SPARSE_MEM builds)
+  import "DPI-C"
+  function int ecc_preload_sparse(input logic [7:0] src[][], input int word_lo, input int stride,
+                                  input int clear, input chandle dst, input int words);
+
+endpackage
@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "elf_loader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ELF32 definitions, kept local so the TB does not depend on <elf.h>
+#define EI_CLASS       4
+#define EI_DATA        5
+#define ELFCLASS32     1
+#define ELFDATA2LSB    1
+#define PT_LOAD        1
+
+struct elf32_ehdr {
+  uint8_t  e_ident[16];
+  uint16_t e_type;
+  uint16_t e_machine;
+  uint32_t e_version;
+  uint32_t e_entry;
+  uint32_t e_phoff;
+  uint32_t e_shoff;
+  uint32_t e_flags;
+  uint16_t e_ehsize;
+  uint16_t e_phentsize;
+  uint16_t e_phnum;
+  uint16_t e_shentsize;
+  uint16_t e_shnum;
+  uint16_t e_shstrndx;
+};
+
+struct elf32_phdr {
+  uint32_t p_type;
+  uint32_t p_offset;
+  uint32_t p_vaddr;
+  uint32_t p_paddr;
+  uint32_t p_filesz;
+  uint32_t p_memsz;
+  uint32_t p_flags;
+  uint32_t p_align;
+};
+
+struct elf_seg {
+  uint32_t addr;
+  uint32_t size;
+  const uint8_t *data;
+};
+
+struct elf_loader_ctx {
+  void *map;
+  size_t map_size;
+  struct elf_seg *segs;
+  int nsegs;
+};
+
+void *elf_loader_open(const char *path) {
+  struct elf_loader_ctx *ctx;
+  struct elf32_ehdr ehdr;
+  struct stat st;
+  int fd;
+
+  fd = open(path, O_RDONLY);
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    fprintf(stderr, "elf_loader: Unable to open %s: %s (%d)\n", path,
+            strerror(errno), errno);
+    if (fd >= 0) {
+      close(fd);
+    }
+    return NULL;
+  }
+  if ((size_t)st.st_size < sizeof(ehdr)) {
+    fprintf(stderr, "elf_loader: %s: file too small\n", path);
+    close(fd);
+    return NULL;
+  }
+
+  ctx = (struct elf_loader_ctx *)calloc(1, sizeof(struct elf_loader_ctx));
+  if (!ctx) {
+    close(fd);
+    return NULL;
+  }
+  ctx->map_size = st.st_size;
+  ctx->map = mmap(NULL, ctx->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (ctx->map == MAP_FAILED) {
+    fprintf(stderr, "elf_loader: Unable to map %s: %s (%d)\n", path,
+            strerror(errno), errno);
+    ctx->map = NULL;
+    elf_loader_close(ctx);
+    return NULL;
+  }
+
+  memcpy(&ehdr, ctx->map, sizeof(ehdr));
+  if (memcmp(ehdr.e_ident, "\x7f" "ELF", 4) != 0 ||
+      ehdr.e_ident[EI_CLASS] != ELFCLASS32 ||
+      ehdr.e_ident[EI_DATA] != ELFDATA2LSB) {
+    fprintf(stderr, "elf_loader: %s: not a little endian ELF32 file\n", path);
+    elf_loader_close(ctx);
+    return NULL;
+  }
+  if (ehdr.e_phentsize != sizeof(struct elf32_phdr) ||
+      (size_t)ehdr.e_phoff + (size_t)ehdr.e_phnum * ehdr.e_phentsize >
+          ctx->map_size) {
+    fprintf(stderr, "elf_loader: %s: bad program header table\n", path);
+    elf_loader_close(ctx);
+    return NULL;
+  }
+
+  ctx->segs = (struct elf_seg *)calloc(ehdr.e_phnum ? ehdr.e_phnum : 1,
+                                       sizeof(struct elf_seg));
+  for (int i = 0; i < ehdr.e_phnum; i++) {
+    struct elf32_phdr ph;
+    memcpy(&ph, (const uint8_t *)ctx->map + ehdr.e_phoff + i * sizeof(ph),
+           sizeof(ph));
+    // .bss style tails (p_memsz > p_filesz) are covered by clearing the memory
+    if (ph.p_type != PT_LOAD || ph.p_filesz == 0) {
+      continue;
+    }
+    if ((size_t)ph.p_offset + ph.p_filesz > ctx->map_size) {
+      fprintf(stderr, "elf_loader: %s: segment %d exceeds file size\n", path,
+              i);
+      elf_loader_close(ctx);
+      return NULL;
+    }
+    ctx->segs[ctx->nsegs].addr = ph.p_paddr;
+    ctx->segs[ctx->nsegs].size = ph.p_filesz;
+    ctx->segs[ctx->nsegs].data = (const uint8_t *)ctx->map + ph.p_offset;
+    ctx->nsegs++;
+  }
+  return ctx;
+}
+
+// Byte range of the memory window, offsets from base
+struct elf_range {
+  uint64_t lo;
+  uint64_t hi;
+};
+
+static int range_cmp(const void *a, const void *b) {
+  const struct elf_range *ra = (const struct elf_range *)a;
+  const struct elf_range *rb = (const struct elf_range *)b;
+
+  return ra->lo < rb->lo ? -1 : ra->lo > rb->lo;
+}
+
+// Storage of the open array when the simulator exposes it: one byte per
+// element (2-state, e.g. Verilator) or one svLogicVecVal per element (the DPI
+// canonical 4-state layout), rows and lanes in index order. 0 when not
+// exposed or when a dimension is descending (e.g. lanes [NUM_BYTES-1:0]),
+// since the storage order is then implementation defined. Every byte then
+// goes through svPutLogicArrElem2VecVal().
+static size_t elem_size(const svOpenArrayHandle mem, uint64_t elems) {
+  int size;
+
+  if (!svGetArrayPtr(mem)) {
+    return 0;
+  }
+  for (int d = 1; d <= svDimensions(mem); d++) {
+    if (svLeft(mem, d) > svRight(mem, d)) {
+      return 0;
+    }
+  }
+  size = svSizeOfArray(mem);
+  if (size < 0) {
+    return 0;
+  }
+  if ((uint64_t)size == elems) {
+    return 1;
+  }
+  if ((uint64_t)size == elems * sizeof(svLogicVecVal)) {
+    return sizeof(svLogicVecVal);
+  }
+  return 0;
+}
+
+// Writes n bytes from data (zeros when NULL) at window offset off
+static void put_bytes(const svOpenArrayHandle mem, size_t esize, int row_lo,
+                      int lane_lo, int lanes, uint64_t off,
+                      const uint8_t *data, uint64_t n) {
+  uint8_t *ptr = (uint8_t *)svGetArrayPtr(mem);
+  svLogicVecVal v;
+
+  if (esize == 1) {
+    if (data) {
+      memcpy(ptr + off, data, n);
+    } else {
+      memset(ptr + off, 0, n);
+    }
+    return;
+  }
+  v.bval = 0;
+  for (uint64_t i = 0; i < n; i++) {
+    v.aval = data ? data[i] : 0;
+    if (esize) {
+      memcpy(ptr + (off + i) * esize, &v, sizeof(v));
+    } else {
+      svPutLogicArrElem2VecVal(mem, &v, row_lo + (int)((off + i) / lanes),
+                               lane_lo + (int)((off + i) % lanes));
+    }
+  }
+}
+
+int elf_loader_load(void *ctx_void, unsigned int base,
+                    const svOpenArrayHandle mem) {
+  struct elf_loader_ctx *ctx = (struct elf_loader_ctx *)ctx_void;
+  struct elf_range *segs;
+  int row_lo, lane_lo, lanes, nsegs = 0, loaded = 0;
+  uint64_t window, cleared = 0;
+  size_t esize;
+
+  if (!ctx) {
+    return -1;
+  }
+  if (svDimensions(mem) != 2) {
+    fprintf(stderr, "elf_loader: memory must be a [row][byte] array\n");
+    return -1;
+  }
+  row_lo = svLow(mem, 1);
+  lane_lo = svLow(mem, 2);
+  lanes = svSize(mem, 2);
+  window = (uint64_t)svSize(mem, 1) * lanes;
+  esize = elem_size(mem, window);
+
+  // Segment bytes inside the window, in address order
+  segs = (struct elf_range *)calloc(ctx->nsegs ? ctx->nsegs : 1,
+                                    sizeof(struct elf_range));
+  if (!segs) {
+    return -1;
+  }
+  for (int i = 0; i < ctx->nsegs; i++) {
+    const struct elf_seg *s = &ctx->segs[i];
+    uint64_t lo = s->addr, hi = (uint64_t)s->addr + s->size;
+
+    if (lo < base) {
+      lo = base;
+    }
+    if (hi > base + window) {
+      hi = base + window;
+    }
+    if (lo < hi) {
+      segs[nsegs].lo = lo - base;
+      segs[nsegs].hi = hi - base;
+      nsegs++;
+    }
+  }
+  qsort(segs, nsegs, sizeof(struct elf_range), range_cmp);
+
+  // Zero the gaps, same contents as a --pad-to padded hex file outside the
+  // image, then copy the segments
+  for (int i = 0; i <= nsegs; i++) {
+    uint64_t gap_hi = i < nsegs ? segs[i].lo : window;
+
+    if (gap_hi > cleared) {
+      put_bytes(mem, esize, row_lo, lane_lo, lanes, cleared, NULL,
+                gap_hi - cleared);
+    }
+    if (i < nsegs && segs[i].hi > cleared) {
+      cleared = segs[i].hi;
+    }
+  }
+  for (int i = 0; i < ctx->nsegs; i++) {
+    const struct elf_seg *s = &ctx->segs[i];
+    uint64_t lo = s->addr, hi = (uint64_t)s->addr + s->size;
+
+    if (lo < base) {
+      lo = base;
+    }
+    if (hi > base + window) {
+      hi = base + window;
+    }
+    if (lo < hi) {
+      put_bytes(mem, esize, row_lo, lane_lo, lanes, lo - base,
+                s->data + (lo - s->addr), hi - lo);
+      loaded += (int)(hi - lo);
+    }
+  }
+  free(segs);
+  return loaded;
+}
+
+void elf_loader_close(void *ctx_void) {
+  struct elf_loader_ctx *ctx = (struct elf_loader_ctx *)ctx_void;
+
+  if (!ctx) {
+    return;
+  }
+  if (ctx->map) {
+    munmap(ctx->map, ctx->map_size);
+  }
+  free(ctx->segs);
+  free(ctx);
+}
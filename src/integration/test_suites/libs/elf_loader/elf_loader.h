@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_ELF_LOADER_H_
+#define CALIPTRA_SS_ELF_LOADER_H_
+
+#include <svdpi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct elf_loader_ctx;
+
+/**
+ * Map a firmware ELF and index its PT_LOAD segments
+ *
+ * Only little endian ELF32 images are accepted. Segments are placed by
+ * physical (load) address, the same address objcopy uses for hex images.
+ *
+ * @param path  ELF file
+ * @return an elf_loader_ctx context object, NULL on error
+ */
+void *elf_loader_open(const char *path);
+
+/**
+ * Backdoor load a TB memory from the ELF
+ *
+ * The memory is a two dimensional array of bytes, [row][byte lane], as used by
+ * the TB rom/sram models. It covers the ELF addresses base to
+ * base + rows * lanes - 1. Every segment byte in that window is written and
+ * the bytes no segment covers are cleared; segments outside the window are
+ * ignored, so the same ELF can be applied to each memory in turn. Where the
+ * simulator exposes the array storage (svGetArrayPtr) and all dimensions are
+ * ascending the bytes are copied directly, otherwise one element is written
+ * per DPI call.
+ *
+ * @param ctx_void  an elf_loader_ctx context object
+ * @param base      ELF address of row 0, lane 0
+ * @param mem       open array handle of the memory
+ * @return number of bytes loaded, -1 on error
+ */
+int elf_loader_load(void *ctx_void, unsigned int base,
+                    const svOpenArrayHandle mem);
+
+/**
+ * Unmap the ELF and free the context
+ *
+ * @param ctx_void  an elf_loader_ctx context object
+ */
+void elf_loader_close(void *ctx_void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_ELF_LOADER_H_
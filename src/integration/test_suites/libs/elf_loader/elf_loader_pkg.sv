@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Firmware ELF backdoor loader
+//
+// DPI imports for elf_loader.c. The TB opens the ELF once and applies it to
+// each memory model with elf_loader_load(), passing the memory's [row][byte]
+// array and the ELF address it starts at. Only PT_LOAD bytes are copied, so
+// load time follows the image size, not the memory size.
+
+package elf_loader_pkg;
+
+  import "DPI-C"
+  function chandle elf_loader_open(input string path);
+
+  import "DPI-C"
+  function int elf_loader_load(input chandle ctx, input int unsigned base, inout logic [7:0] mem[][]);
+
+  import "DPI-C"
+  function void elf_loader_close(input chandle ctx);
+
+endpackage
@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "func_cov.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Name lookup, open addressing over bin index + 1
+#define HASH_SIZE (2 * FUNC_COV_MAX_BINS)
+
+struct func_cov_ctx {
+  struct func_cov_table *table;
+  unsigned short hash[HASH_SIZE];
+  int full_warned;
+  unsigned char trunc_warned[FUNC_COV_MAX_BINS];
+};
+
+static unsigned int name_hash(const char *name) {
+  unsigned int h = 2166136261u;  // FNV-1a
+
+  for (; *name; name++) {
+    h = (h ^ (unsigned char)*name) * 16777619u;
+  }
+  return h;
+}
+
+void *func_cov_open(const char *path) {
+  struct func_cov_ctx *ctx;
+  void *map;
+  int fd;
+
+  fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || ftruncate(fd, sizeof(struct func_cov_table)) != 0) {
+    fprintf(stderr, "func_cov: Unable to create %s: %s (%d)\n", path,
+            strerror(errno), errno);
+    if (fd >= 0) {
+      close(fd);
+    }
+    return NULL;
+  }
+  map = mmap(NULL, sizeof(struct func_cov_table), PROT_READ | PROT_WRITE,
+             MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    fprintf(stderr, "func_cov: Unable to map %s: %s (%d)\n", path,
+            strerror(errno), errno);
+    return NULL;
+  }
+  ctx = (struct func_cov_ctx *)calloc(1, sizeof(struct func_cov_ctx));
+  if (!ctx) {
+    munmap(map, sizeof(struct func_cov_table));
+    return NULL;
+  }
+  ctx->table = (struct func_cov_table *)map;
+  memcpy(ctx->table->magic, FUNC_COV_MAGIC, sizeof(ctx->table->magic));
+  ctx->table->version = FUNC_COV_VERSION;
+  ctx->table->runs = 1;
+  return ctx;
+}
+
+// Names sharing the first FUNC_COV_NAME_LEN - 1 characters share a bin
+static void warn_truncated(struct func_cov_ctx *ctx, int bin, const char *name,
+                           const char *key) {
+  if (!ctx->trunc_warned[bin]) {
+    fprintf(stderr,
+            "func_cov: Bin name %s is longer than %d characters, counted as "
+            "%s\n",
+            name, FUNC_COV_NAME_LEN - 1, key);
+    ctx->trunc_warned[bin] = 1;
+  }
+}
+
+int func_cov_bin(void *ctx_void, const char *name) {
+  struct func_cov_ctx *ctx = (struct func_cov_ctx *)ctx_void;
+  struct func_cov_table *t;
+  char key[FUNC_COV_NAME_LEN];
+  unsigned int h;
+  int truncated;
+
+  if (!ctx) {
+    return -1;
+  }
+  t = ctx->table;
+  truncated = snprintf(key, sizeof(key), "%s", name) >= (int)sizeof(key);
+  for (h = name_hash(key) % HASH_SIZE; ctx->hash[h]; h = (h + 1) % HASH_SIZE) {
+    if (!strcmp(t->bins[ctx->hash[h] - 1].name, key)) {
+      if (truncated) {
+        warn_truncated(ctx, ctx->hash[h] - 1, name, key);
+      }
+      return ctx->hash[h] - 1;
+    }
+  }
+  if (t->nbins == FUNC_COV_MAX_BINS) {
+    if (!ctx->full_warned) {
+      fprintf(stderr, "func_cov: More than %d bins, %s and later are dropped\n",
+              FUNC_COV_MAX_BINS, key);
+      ctx->full_warned = 1;
+    }
+    return -1;
+  }
+  if (truncated) {
+    warn_truncated(ctx, (int)t->nbins, name, key);
+  }
+  memcpy(t->bins[t->nbins].name, key, sizeof(key));
+  ctx->hash[h] = (unsigned short)(t->nbins + 1);
+  return t->nbins++;
+}
+
+void func_cov_hit(void *ctx_void, int bin) {
+  struct func_cov_ctx *ctx = (struct func_cov_ctx *)ctx_void;
+
+  if (ctx && bin >= 0 && (unsigned int)bin < ctx->table->nbins) {
+    ctx->table->bins[bin].hits++;
+  }
+}
+
+void func_cov_sample(void *ctx, const char *name) {
+  func_cov_hit(ctx, func_cov_bin(ctx, name));
+}
+
+void func_cov_close(void *ctx_void) {
+  struct func_cov_ctx *ctx = (struct func_cov_ctx *)ctx_void;
+  unsigned int hit = 0;
+
+  if (!ctx) {
+    return;
+  }
+  for (unsigned int i = 0; i < ctx->table->nbins; i++) {
+    hit += ctx->table->bins[i].hits != 0;
+  }
+  printf("func cov: %u/%u bins hit\n", hit, ctx->table->nbins);
+  fflush(stdout);
+  munmap(ctx->table, sizeof(struct func_cov_table));
+  free(ctx);
+}
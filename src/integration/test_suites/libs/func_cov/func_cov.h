@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_FUNC_COV_H_
+#define CALIPTRA_SS_FUNC_COV_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Hit table layout, shared with tools/func_cov_merge
+ *
+ * The table is a file mapped into the simulator, so counts are in the file
+ * as soon as they are taken, also when the run is killed. Bins are named
+ * "<group>.<bin>", e.g. "boot_fsm.BOOT_LCC->BOOT_BREAKPOINT".
+ */
+#define FUNC_COV_MAGIC    "CSSFCOV1"
+#define FUNC_COV_VERSION  1
+#define FUNC_COV_MAX_BINS 4096
+#define FUNC_COV_NAME_LEN 48
+
+/** Table header flags */
+#define FUNC_COV_MERGED 0x1  // written by func_cov_merge, bin runs are valid
+
+struct func_cov_entry {
+  char name[FUNC_COV_NAME_LEN];
+  uint64_t hits;
+  uint64_t runs;  // runs with hits != 0, merged tables only
+};
+
+struct func_cov_table {
+  char magic[8];
+  uint32_t version;
+  uint32_t nbins;
+  uint32_t flags;
+  uint32_t reserved;
+  uint64_t runs;
+  uint8_t pad[32];
+  struct func_cov_entry bins[FUNC_COV_MAX_BINS];
+};
+
+/**
+ * Create the hit table of this run
+ *
+ * @param path table file, e.g. func_cov.dat; an existing file is replaced
+ * @return handle, NULL on error
+ */
+void *func_cov_open(const char *path);
+
+/**
+ * Declare a bin, so it is reported (as a hole) even when never hit
+ *
+ * @param name "<group>.<bin>", truncated with a warning to
+ *             FUNC_COV_NAME_LEN - 1 characters
+ * @return bin index for func_cov_hit(), -1 when the table is full
+ */
+int func_cov_bin(void *ctx, const char *name);
+
+/** Count a hit of a bin returned by func_cov_bin() */
+void func_cov_hit(void *ctx, int bin);
+
+/** Count a hit by name, declaring the bin on its first hit */
+void func_cov_sample(void *ctx, const char *name);
+
+/** Print the number of bins hit and unmap the table */
+void func_cov_close(void *ctx);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_FUNC_COV_H_
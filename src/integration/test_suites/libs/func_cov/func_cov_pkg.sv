@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Functional coverage counters
+//
+// DPI imports for func_cov.c, used by css_func_cov.
+
+package func_cov_pkg;
+
+  import "DPI-C"
+  function chandle func_cov_open(input string path);
+
+  import "DPI-C"
+  function int func_cov_bin(input chandle ctx, input string name);
+
+  import "DPI-C"
+  function void func_cov_hit(input chandle ctx, input int bin);
+
+  import "DPI-C"
+  function void func_cov_sample(input chandle ctx, input string name);
+
+  import "DPI-C"
+  function void func_cov_close(input chandle ctx);
+
+endpackage
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mem_dump.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sparse_mem.h"
+
+struct mem_dump {
+  int words;
+  uint32_t *buf;
+};
+
+void *mem_dump_begin(int words) {
+  struct mem_dump *d;
+
+  if (words < 0) {
+    return NULL;
+  }
+  d = (struct mem_dump *)calloc(1, sizeof(struct mem_dump));
+  if (!d) {
+    return NULL;
+  }
+  d->words = words;
+  d->buf = (uint32_t *)calloc(words ? words : 1, sizeof(uint32_t));
+  if (!d->buf) {
+    free(d);
+    return NULL;
+  }
+  return d;
+}
+
+// Clip k = 0..n-1 to the part that lands inside both buffer and source
+static int clip(const struct mem_dump *d, int src_size, int src_lo, int pos,
+                int step, int n) {
+  if (src_lo < 0 || pos < 0 || step <= 0) {
+    return 0;
+  }
+  if (src_lo + n > src_size) {
+    n = src_size - src_lo;
+  }
+  if (n > 0 && pos + (long long)(n - 1) * step >= d->words) {
+    n = (d->words - 1 - pos) / step + 1;
+  }
+  return n > 0 ? n : 0;
+}
+
+void mem_dump_reg(void *dump, const svOpenArrayHandle src, int src_lo, int pos,
+                  int step, int n) {
+  struct mem_dump *d = (struct mem_dump *)dump;
+  svLogicVecVal v[2];
+  int lo;
+
+  if (!d || svDimensions(src) != 1) {
+    return;
+  }
+  lo = svLow(src, 1);
+  n = clip(d, svSize(src, 1), src_lo, pos, step, n);
+  for (int k = 0; k < n; k++) {
+    svGetLogicArrElem1VecVal(v, src, lo + src_lo + k);
+    d->buf[pos + k * step] = v[0].aval & ~v[0].bval;
+  }
+}
+
+void mem_dump_bit(void *dump, const svOpenArrayHandle src, int src_lo, int pos,
+                  int step, int n) {
+  struct mem_dump *d = (struct mem_dump *)dump;
+  svBitVecVal v[2];
+  int lo;
+
+  if (!d || svDimensions(src) != 1) {
+    return;
+  }
+  lo = svLow(src, 1);
+  n = clip(d, svSize(src, 1), src_lo, pos, step, n);
+  for (int k = 0; k < n; k++) {
+    svGetBitArrElem1VecVal(v, src, lo + src_lo + k);
+    d->buf[pos + k * step] = v[0];
+  }
+}
+
+void mem_dump_bytes(void *dump, const svOpenArrayHandle src, int byte_lo,
+                    int pos, int n) {
+  struct mem_dump *d = (struct mem_dump *)dump;
+  svLogicVecVal v;
+  int row_lo, lane_lo, lanes;
+  long long size;
+
+  if (!d || svDimensions(src) != 2 || byte_lo < 0) {
+    return;
+  }
+  row_lo = svLow(src, 1);
+  lane_lo = svLow(src, 2);
+  lanes = svSize(src, 2);
+  size = (long long)svSize(src, 1) * lanes;
+  if (pos < 0) {
+    return;
+  }
+  if (pos + n > d->words) {
+    n = d->words - pos;
+  }
+  for (int k = 0; k < n; k++) {
+    uint32_t w = 0;
+    for (int i = 0; i < 4; i++) {
+      long long b = byte_lo + 4LL * k + i;
+      if (b >= size) {
+        break;
+      }
+      svGetLogicArrElem2VecVal(&v, src, row_lo + (int)(b / lanes),
+                               lane_lo + (int)(b % lanes));
+      w |= ((v.aval & ~v.bval) & 0xff) << (8 * i);
+    }
+    d->buf[pos + k] = w;
+  }
+}
+
+void mem_dump_sparse(void *dump, void *mem, int src_lo, int pos, int step,
+                     int n) {
+  struct mem_dump *d = (struct mem_dump *)dump;
+
+  if (!d || !mem) {
+    return;
+  }
+  n = clip(d, src_lo + n, src_lo, pos, step, n);
+  for (int k = 0; k < n; k++) {
+    d->buf[pos + k * step] = (uint32_t)sparse_mem_read(mem, src_lo + k);
+  }
+}
+
+int mem_dump_finish(void *dump, const char *path, int binary) {
+  struct mem_dump *d = (struct mem_dump *)dump;
+  FILE *fp;
+  int ret;
+
+  if (!d) {
+    return -1;
+  }
+  fp = fopen(path, binary ? "wb" : "w");
+  if (!fp) {
+    fprintf(stderr, "mem_dump: Unable to open %s: %s (%d)\n", path,
+            strerror(errno), errno);
+    ret = -1;
+  } else if (binary) {
+    // Little endian host, the words are written as they are
+    ret = (int)fwrite(d->buf, sizeof(uint32_t), d->words, fp);
+    fclose(fp);
+  } else {
+    // One formatting pass into memory, one write
+    char *txt = (char *)malloc((size_t)d->words * 9 + 1);
+    static const char hex[] = "0123456789ABCDEF";
+    ret = d->words;
+    if (txt) {
+      char *p = txt;
+      for (int i = 0; i < d->words; i++) {
+        for (int s = 28; s >= 0; s -= 4) {
+          *p++ = hex[(d->buf[i] >> s) & 0xf];
+        }
+        *p++ = '\n';
+      }
+      fwrite(txt, 1, p - txt, fp);
+      free(txt);
+    } else {
+      for (int i = 0; i < d->words; i++) {
+        fprintf(fp, "%08X\n", d->buf[i]);
+      }
+    }
+    fclose(fp);
+  }
+  free(d->buf);
+  free(d);
+  return ret;
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_MEM_DUMP_H_
+#define CALIPTRA_SS_MEM_DUMP_H_
+
+#include <stdint.h>
+#include <svdpi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start a dump of words 32-bit words
+ *
+ * The dump is assembled in memory from any number of TB memories with the
+ * mem_dump_*() gather calls below, then written out with mem_dump_finish().
+ * Words no call fills are 0.
+ *
+ * @return handle, NULL on error
+ */
+void *mem_dump_begin(int words);
+
+/**
+ * Gather from a 1-D memory: dump word pos + k * step <= src[src_lo + k][31:0]
+ * for k = 0..n-1. src_lo is relative to the first element of src. Use
+ * step > 1 for banked (interleaved) memories such as the DCCM.
+ */
+void mem_dump_reg(void *dump, const svOpenArrayHandle src, int src_lo, int pos,
+                  int step, int n);
+
+/** Same as mem_dump_reg(), for a 2-state source array */
+void mem_dump_bit(void *dump, const svOpenArrayHandle src, int src_lo, int pos,
+                  int step, int n);
+
+/**
+ * Gather from a [row][lane] byte memory: dump word pos + k <= little endian
+ * 32-bit word at byte offset byte_lo + 4 * k, for k = 0..n-1
+ */
+void mem_dump_bytes(void *dump, const svOpenArrayHandle src, int byte_lo,
+                    int pos, int n);
+
+/** Same as mem_dump_reg(), from a sparse_mem memory */
+void mem_dump_sparse(void *dump, void *mem, int src_lo, int pos, int step,
+                     int n);
+
+/**
+ * Write the dump to path and release it
+ *
+ * @param binary 0: one "%08X" word per line, 1: raw little endian words
+ * @return number of words written, -1 on error
+ */
+int mem_dump_finish(void *dump, const char *path, int binary);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_MEM_DUMP_H_
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Bulk memory dump
+//
+// DPI imports for mem_dump.c. A dump is gathered from one or more TB memories
+// into a word buffer and written to a file in one go, replacing per-word
+// $fwrite loops.
+
+package mem_dump_pkg;
+
+  import "DPI-C"
+  function chandle mem_dump_begin(input int words);
+
+  // Dump word pos + k * step <= src[src_lo + k][31:0], k = 0..n-1
+  import "DPI-C"
+  function void mem_dump_reg(input chandle dump, input logic [38:0] src[], input int src_lo,
+                             input int pos, input int step, input int n);
+
+  import "DPI-C"
+  function void mem_dump_bit(input chandle dump, input bit [38:0] src[], input int src_lo,
+                             input int pos, input int step, input int n);
+
+  // Dump word pos + k <= bytes byte_lo + 4 * k .. + 3 of a [row][lane] memory
+  import "DPI-C"
+  function void mem_dump_bytes(input chandle dump, input logic [7:0] src[][], input int byte_lo,
+                               input int pos, input int n);
+
+  import "DPI-C"
+  function void mem_dump_sparse(input chandle dump, input chandle mem, input int src_lo,
+                                input int pos, input int step, input int n);
+
+  // binary = 0: "%08X" per line, 1: raw little endian words. Returns words written.
+  import "DPI-C"
+  function int mem_dump_finish(input chandle dump, input string path, input int binary);
+
+endpackage
@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sim_telemetry.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_PHASES      64
+#define PHASE_NAME_LEN  48
+
+struct counters {
+  double wall_s;
+  double sim_ns;
+  uint32_t cycle;
+  uint32_t mcu_instret;
+  uint32_t cptra_instret;
+};
+
+struct phase {
+  char name[PHASE_NAME_LEN];
+  double wall_s;
+  double sim_ns;
+  uint64_t cycles;
+  uint64_t mcu_instret;
+  uint64_t cptra_instret;
+};
+
+struct sim_telemetry_ctx {
+  FILE *fp;
+  struct timespec t0;
+  struct counters last;
+  struct phase phases[MAX_PHASES];
+  int nphases;
+};
+
+static double wall_now(const struct sim_telemetry_ctx *ctx) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)(t.tv_sec - ctx->t0.tv_sec) +
+         (double)(t.tv_nsec - ctx->t0.tv_nsec) * 1e-9;
+}
+
+static double rate(double n, double secs) { return secs > 0 ? n / secs : 0; }
+
+void *sim_telemetry_open(const char *path) {
+  struct sim_telemetry_ctx *ctx;
+
+  ctx = (struct sim_telemetry_ctx *)calloc(1, sizeof(struct sim_telemetry_ctx));
+  if (!ctx) {
+    return NULL;
+  }
+  ctx->fp = fopen(path, "w");
+  if (!ctx->fp) {
+    fprintf(stderr, "sim_telemetry: Unable to open %s: %s (%d)\n", path,
+            strerror(errno), errno);
+    free(ctx);
+    return NULL;
+  }
+  clock_gettime(CLOCK_MONOTONIC, &ctx->t0);
+  // Time before the first phase is accounted to "init"
+  strcpy(ctx->phases[0].name, "init");
+  ctx->nphases = 1;
+  return ctx;
+}
+
+void sim_telemetry_sample(void *ctx_void, int cycle, double sim_ns,
+                          int mcu_instret, int cptra_instret) {
+  struct sim_telemetry_ctx *ctx = (struct sim_telemetry_ctx *)ctx_void;
+  struct counters now;
+  struct phase *ph;
+  double dt;
+  uint32_t dc, dm, dp;
+
+  if (!ctx) {
+    return;
+  }
+  now.wall_s = wall_now(ctx);
+  now.sim_ns = sim_ns;
+  now.cycle = (uint32_t)cycle;
+  now.mcu_instret = (uint32_t)mcu_instret;
+  now.cptra_instret = (uint32_t)cptra_instret;
+
+  dt = now.wall_s - ctx->last.wall_s;
+  dc = now.cycle - ctx->last.cycle;
+  dm = now.mcu_instret - ctx->last.mcu_instret;
+  dp = now.cptra_instret - ctx->last.cptra_instret;
+
+  ph = &ctx->phases[ctx->nphases - 1];
+  ph->wall_s += dt;
+  ph->sim_ns += now.sim_ns - ctx->last.sim_ns;
+  ph->cycles += dc;
+  ph->mcu_instret += dm;
+  ph->cptra_instret += dp;
+
+  fprintf(ctx->fp,
+          "{\"type\": \"sample\", \"phase\": \"%s\", \"wall_s\": %.3f, "
+          "\"sim_ns\": %.1f, \"cycle\": %u, \"mcu_instret\": %u, "
+          "\"cptra_instret\": %u, \"cycles_per_s\": %.1f, \"mcu_kips\": %.3f, "
+          "\"cptra_kips\": %.3f}\n",
+          ph->name, now.wall_s, now.sim_ns, now.cycle, now.mcu_instret,
+          now.cptra_instret, rate(dc, dt), rate(dm, dt) / 1e3,
+          rate(dp, dt) / 1e3);
+  ctx->last = now;
+}
+
+void sim_telemetry_phase(void *ctx_void, const char *name, int cycle,
+                         double sim_ns, int mcu_instret, int cptra_instret) {
+  struct sim_telemetry_ctx *ctx = (struct sim_telemetry_ctx *)ctx_void;
+  struct phase *ph;
+
+  if (!ctx) {
+    return;
+  }
+  sim_telemetry_sample(ctx, cycle, sim_ns, mcu_instret, cptra_instret);
+  // Past the table the last entry keeps accumulating
+  if (ctx->nphases < MAX_PHASES) {
+    ctx->nphases++;
+  }
+  ph = &ctx->phases[ctx->nphases - 1];
+  memset(ph, 0, sizeof(*ph));
+  snprintf(ph->name, sizeof(ph->name), "%s", name);
+  fprintf(ctx->fp,
+          "{\"type\": \"phase\", \"phase\": \"%s\", \"wall_s\": %.3f, "
+          "\"sim_ns\": %.1f, \"cycle\": %u}\n",
+          ph->name, ctx->last.wall_s, ctx->last.sim_ns, ctx->last.cycle);
+}
+
+void sim_telemetry_close(void *ctx_void, int cycle, double sim_ns,
+                         int mcu_instret, int cptra_instret) {
+  struct sim_telemetry_ctx *ctx = (struct sim_telemetry_ctx *)ctx_void;
+  double wall = 0;
+
+  if (!ctx) {
+    return;
+  }
+  sim_telemetry_sample(ctx, cycle, sim_ns, mcu_instret, cptra_instret);
+  for (int i = 0; i < ctx->nphases; i++) {
+    wall += ctx->phases[i].wall_s;
+  }
+
+  printf("\nsim telemetry: %-24s %10s %6s %12s %12s %10s %10s\n", "phase",
+         "wall_s", "wall%", "cycles", "cycles/s", "mcu_kips", "cptra_kips");
+  for (int i = 0; i < ctx->nphases; i++) {
+    const struct phase *ph = &ctx->phases[i];
+    if (!ph->cycles && ph->wall_s < 0.0005) {
+      continue;
+    }
+    printf("sim telemetry: %-24s %10.2f %5.1f%% %12llu %12.1f %10.3f %10.3f\n",
+           ph->name, ph->wall_s, wall > 0 ? 100.0 * ph->wall_s / wall : 0.0,
+           (unsigned long long)ph->cycles, rate(ph->cycles, ph->wall_s),
+           rate(ph->mcu_instret, ph->wall_s) / 1e3,
+           rate(ph->cptra_instret, ph->wall_s) / 1e3);
+    fprintf(ctx->fp,
+            "{\"type\": \"summary\", \"phase\": \"%s\", \"wall_s\": %.3f, "
+            "\"sim_ns\": %.1f, \"cycles\": %llu, \"mcu_instret\": %llu, "
+            "\"cptra_instret\": %llu, \"cycles_per_s\": %.1f, "
+            "\"mcu_kips\": %.3f, \"cptra_kips\": %.3f}\n",
+            ph->name, ph->wall_s, ph->sim_ns, (unsigned long long)ph->cycles,
+            (unsigned long long)ph->mcu_instret,
+            (unsigned long long)ph->cptra_instret,
+            rate(ph->cycles, ph->wall_s),
+            rate(ph->mcu_instret, ph->wall_s) / 1e3,
+            rate(ph->cptra_instret, ph->wall_s) / 1e3);
+  }
+  fflush(stdout);
+  fclose(ctx->fp);
+  free(ctx);
+}
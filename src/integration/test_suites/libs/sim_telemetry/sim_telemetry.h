@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_SIM_TELEMETRY_H_
+#define CALIPTRA_SS_SIM_TELEMETRY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Open the telemetry timeline
+ *
+ * Host wall clock time is measured from this call. Counters passed to the
+ * other calls are 32-bit and may wrap; only their differences are used.
+ *
+ * @param path JSON-lines timeline, e.g. sim_telemetry.jsonl
+ * @return handle, NULL on error
+ */
+void *sim_telemetry_open(const char *path);
+
+/**
+ * Record a sample: host and simulated time, cycles and retired instructions
+ * since the previous sample, and the rates over that interval
+ *
+ * @param cycle         TB cycle count (core_clk)
+ * @param sim_ns        simulated time in ns
+ * @param mcu_instret   MCU minstret
+ * @param cptra_instret Caliptra core minstret
+ */
+void sim_telemetry_sample(void *ctx, int cycle, double sim_ns,
+                          int mcu_instret, int cptra_instret);
+
+/**
+ * End the current phase and start a new one; takes a sample first. The
+ * summary reports the host time, cycles and instructions of each phase.
+ */
+void sim_telemetry_phase(void *ctx, const char *name, int cycle,
+                         double sim_ns, int mcu_instret, int cptra_instret);
+
+/**
+ * Take a last sample, write the per phase summary to the timeline and to
+ * stdout, and close the timeline
+ */
+void sim_telemetry_close(void *ctx, int cycle, double sim_ns,
+                         int mcu_instret, int cptra_instret);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_SIM_TELEMETRY_H_
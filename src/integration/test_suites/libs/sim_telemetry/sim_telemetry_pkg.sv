@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Simulation speed telemetry
+//
+// DPI imports for sim_telemetry.c, used by css_sim_telemetry.
+
+package sim_telemetry_pkg;
+
+  import "DPI-C"
+  function chandle sim_telemetry_open(input string path);
+
+  import "DPI-C"
+  function void sim_telemetry_sample(input chandle ctx, input int cycle, input real sim_ns,
+                                     input int mcu_instret, input int cptra_instret);
+
+  import "DPI-C"
+  function void sim_telemetry_phase(input chandle ctx, input string name, input int cycle, input real sim_ns,
+                                    input int mcu_instret, input int cptra_instret);
+
+  import "DPI-C"
+  function void sim_telemetry_close(input chandle ctx, input int cycle, input real sim_ns,
+                                    input int mcu_instret, input int cptra_instret);
+
+endpackage
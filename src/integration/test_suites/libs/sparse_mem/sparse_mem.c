@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sparse_mem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PAGE_BYTES 4096
+
+struct sparse_mem {
+  char name[128];
+  uint64_t words;
+  uint64_t mask;
+  uint64_t fill_word;
+  int slot_bytes;       // 1, 2, 4 or 8 bytes of storage per word
+  int page_shift;       // log2(words per page)
+  int ecc_bits;
+  uint8_t fill;
+  uint64_t npages;
+  uint8_t **data;       // [npages], NULL until written
+  uint8_t **ecc;        // [npages], NULL until written, ecc_bits > 0 only
+  uint64_t allocated;
+  uint64_t peak;
+};
+
+void *sparse_mem_new(const char *name, uint64_t words, int width_bits,
+                     int ecc_bits, uint8_t fill) {
+  struct sparse_mem *m;
+  uint64_t words_per_page;
+
+  if (width_bits < 1 || width_bits > 64 || ecc_bits < 0 || ecc_bits > 8 ||
+      words == 0) {
+    fprintf(stderr, "sparse_mem: %s: unsupported geometry (%llu x %d+%d)\n",
+            name, (unsigned long long)words, width_bits, ecc_bits);
+    return NULL;
+  }
+  m = (struct sparse_mem *)calloc(1, sizeof(struct sparse_mem));
+  if (!m) {
+    return NULL;
+  }
+  snprintf(m->name, sizeof(m->name), "%s", name);
+  m->words = words;
+  m->mask = width_bits == 64 ? ~0ULL : (1ULL << width_bits) - 1;
+  m->slot_bytes = 1;
+  while (m->slot_bytes * 8 < width_bits) {
+    m->slot_bytes *= 2;
+  }
+  words_per_page = PAGE_BYTES / m->slot_bytes;
+  while ((1ULL << m->page_shift) < words_per_page) {
+    m->page_shift++;
+  }
+  m->ecc_bits = ecc_bits;
+  m->fill = fill;
+  memset(&m->fill_word, fill, sizeof(m->fill_word));
+  m->fill_word &= m->mask;
+  m->npages = (words + words_per_page - 1) >> m->page_shift;
+  m->data = (uint8_t **)calloc(m->npages, sizeof(uint8_t *));
+  if (ecc_bits) {
+    m->ecc = (uint8_t **)calloc(m->npages, sizeof(uint8_t *));
+  }
+  if (!m->data || (ecc_bits && !m->ecc)) {
+    sparse_mem_free(m);
+    return NULL;
+  }
+  return m;
+}
+
+static uint8_t *page(struct sparse_mem *m, uint64_t pg) {
+  uint8_t *p = m->data[pg];
+
+  if (!p) {
+    p = (uint8_t *)malloc(PAGE_BYTES);
+    if (!p) {
+      fprintf(stderr, "sparse_mem: %s: out of memory\n", m->name);
+      abort();
+    }
+    memset(p, m->fill, PAGE_BYTES);
+    m->data[pg] = p;
+    if (++m->allocated > m->peak) {
+      m->peak = m->allocated;
+    }
+  }
+  return p;
+}
+
+uint64_t sparse_mem_read(void *mem, uint64_t idx) {
+  struct sparse_mem *m = (struct sparse_mem *)mem;
+  const uint8_t *p;
+  uint64_t v = 0;
+
+  if (!m || idx >= m->words) {
+    return 0;
+  }
+  p = m->data[idx >> m->page_shift];
+  if (!p) {
+    return m->fill_word;
+  }
+  // Little endian host: the low slot_bytes of v
+  memcpy(&v, p + (idx & ((1ULL << m->page_shift) - 1)) * m->slot_bytes,
+         m->slot_bytes);
+  return v & m->mask;
+}
+
+void sparse_mem_write(void *mem, uint64_t idx, uint64_t data) {
+  struct sparse_mem *m = (struct sparse_mem *)mem;
+  uint64_t pg;
+
+  if (!m || idx >= m->words) {
+    return;
+  }
+  data &= m->mask;
+  pg = idx >> m->page_shift;
+  // Keep untouched pages unallocated
+  if (!m->data[pg] && data == m->fill_word) {
+    return;
+  }
+  memcpy(page(m, pg) + (idx & ((1ULL << m->page_shift) - 1)) * m->slot_bytes,
+         &data, m->slot_bytes);
+}
+
+uint8_t sparse_mem_read_ecc(void *mem, uint64_t idx) {
+  struct sparse_mem *m = (struct sparse_mem *)mem;
+  const uint8_t *e;
+
+  if (!m || !m->ecc || idx >= m->words) {
+    return 0;
+  }
+  e = m->ecc[idx >> m->page_shift];
+  return e ? e[idx & ((1ULL << m->page_shift) - 1)] : 0;
+}
+
+void sparse_mem_write_ecc(void *mem, uint64_t idx, uint8_t ecc) {
+  struct sparse_mem *m = (struct sparse_mem *)mem;
+  uint64_t pg;
+
+  if (!m || !m->ecc || idx >= m->words) {
+    return;
+  }
+  ecc &= (uint8_t)((1u << m->ecc_bits) - 1);
+  pg = idx >> m->page_shift;
+  if (!m->ecc[pg]) {
+    if (!ecc) {
+      return;
+    }
+    m->ecc[pg] = (uint8_t *)calloc(1ULL << m->page_shift, 1);
+    if (!m->ecc[pg]) {
+      fprintf(stderr, "sparse_mem: %s: out of memory\n", m->name);
+      abort();
+    }
+  }
+  m->ecc[pg][idx & ((1ULL << m->page_shift) - 1)] = ecc;
+}
+
+void sparse_mem_clear(void *mem) {
+  struct sparse_mem *m = (struct sparse_mem *)mem;
+
+  if (!m) {
+    return;
+  }
+  for (uint64_t i = 0; i < m->npages; i++) {
+    free(m->data[i]);
+    m->data[i] = NULL;
+    if (m->ecc) {
+      free(m->ecc[i]);
+      m->ecc[i] = NULL;
+    }
+  }
+  m->allocated = 0;
+}
+
+uint64_t sparse_mem_pages(void *mem) {
+  struct sparse_mem *m = (struct sparse_mem *)mem;
+
+  return m ? m->allocated : 0;
+}
+
+void sparse_mem_free(void *mem) {
+  struct sparse_mem *m = (struct sparse_mem *)mem;
+
+  if (!m) {
+    return;
+  }
+  if (m->data) {
+    printf("sparse_mem: %s: %llu of %llu pages used (peak %llu, %llu KiB)\n",
+           m->name, (unsigned long long)m->allocated,
+           (unsigned long long)m->npages, (unsigned long long)m->peak,
+           (unsigned long long)m->peak * PAGE_BYTES / 1024);
+    sparse_mem_clear(m);
+  }
+  free(m->data);
+  free(m->ecc);
+  free(m);
+}
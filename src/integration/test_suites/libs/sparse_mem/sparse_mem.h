@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_SPARSE_MEM_H_
+#define CALIPTRA_SS_SPARSE_MEM_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a sparse memory
+ *
+ * Storage is allocated in 4 KiB pages on the first write of a value other
+ * than the fill value; unwritten words read as the fill byte repeated over
+ * the word. Words with ECC bits keep them in a separate side array per page,
+ * also allocated on first use.
+ *
+ * @param name       instance name for messages and statistics
+ * @param words      depth in words
+ * @param width_bits data width, 1..64
+ * @param ecc_bits   ECC side-band width, 0..8
+ * @param fill       fill byte of unwritten memory
+ * @return handle, NULL on error
+ */
+void *sparse_mem_new(const char *name, uint64_t words, int width_bits,
+                     int ecc_bits, uint8_t fill);
+
+/** Read word idx, 0 past the end */
+uint64_t sparse_mem_read(void *mem, uint64_t idx);
+
+/** Write word idx, bits above the data width are dropped */
+void sparse_mem_write(void *mem, uint64_t idx, uint64_t data);
+
+/** ECC side-band of word idx */
+uint8_t sparse_mem_read_ecc(void *mem, uint64_t idx);
+void sparse_mem_write_ecc(void *mem, uint64_t idx, uint8_t ecc);
+
+/** Return all words to the fill value, releasing the pages */
+void sparse_mem_clear(void *mem);
+
+/** Number of allocated data pages */
+uint64_t sparse_mem_pages(void *mem);
+
+/** Release the memory, printing its page statistics */
+void sparse_mem_free(void *mem);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_SPARSE_MEM_H_
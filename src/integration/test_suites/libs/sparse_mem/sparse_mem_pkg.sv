@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Sparse memory model
+//
+// DPI imports for sparse_mem.c: word memories backed by lazily allocated
+// 4 KiB pages, for TB memories that are large but mostly unused.
+
+package sparse_mem_pkg;
+
+  import "DPI-C"
+  function chandle sparse_mem_new(input string name, input longint unsigned words, input int width_bits,
+                                  input int ecc_bits, input byte unsigned fill);
+
+  import "DPI-C"
+  function longint unsigned sparse_mem_read(input chandle mem, input longint unsigned idx);
+
+  import "DPI-C"
+  function void sparse_mem_write(input chandle mem, input longint unsigned idx, input longint unsigned data);
+
+  import "DPI-C"
+  function byte unsigned sparse_mem_read_ecc(input chandle mem, input longint unsigned idx);
+
+  import "DPI-C"
+  function void sparse_mem_write_ecc(input chandle mem, input longint unsigned idx, input byte unsigned ecc);
+
+  import "DPI-C"
+  function void sparse_mem_clear(input chandle mem);
+
+  import "DPI-C"
+  function longint unsigned sparse_mem_pages(input chandle mem);
+
+  import "DPI-C"
+  function void sparse_mem_free(input chandle mem);
+
+endpackage
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "trace_sink.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef TRACE_SINK_ZSTD
+#include <zstd.h>
+#endif
+
+// Buffers in rotation between the simulator thread and the flush thread
+#define TRACE_SINK_NBUF         4
+#define TRACE_SINK_DEF_RECORDS  (64 * 1024)
+
+struct trace_sink_ctx {
+  char *path;
+  FILE *fp;
+  int level;
+
+  struct trace_rec *buf[TRACE_SINK_NBUF];
+  size_t fill[TRACE_SINK_NBUF];
+  size_t cap;
+
+  // Producer side: buffer being filled, -1 if none
+  int cur;
+
+  // Buffer index queues, protected by lock
+  pthread_mutex_t lock;
+  pthread_cond_t full_cv;
+  pthread_cond_t free_cv;
+  int full_q[TRACE_SINK_NBUF];
+  int full_head, full_cnt;
+  int free_q[TRACE_SINK_NBUF];
+  int free_head, free_cnt;
+  int stop;
+
+  pthread_t thread;
+  void *zbuf;
+  size_t zcap;
+  unsigned long long records;
+  int error;
+};
+
+/**
+ * Write a chunk to the file, compressed into its own zstd frame if enabled.
+ * Only called from one thread at a time (open, then the flush thread).
+ */
+static void sink_write(struct trace_sink_ctx *ctx, const void *src, size_t n) {
+  const void *out = src;
+  size_t out_n = n;
+
+  if (ctx->error || n == 0) {
+    return;
+  }
+#ifdef TRACE_SINK_ZSTD
+  if (ctx->level) {
+    out_n = ZSTD_compress(ctx->zbuf, ctx->zcap, src, n, ctx->level);
+    if (ZSTD_isError(out_n)) {
+      fprintf(stderr, "trace_sink: %s: zstd error: %s\n", ctx->path,
+              ZSTD_getErrorName(out_n));
+      ctx->error = 1;
+      return;
+    }
+    out = ctx->zbuf;
+  }
+#endif
+  if (fwrite(out, 1, out_n, ctx->fp) != out_n) {
+    fprintf(stderr, "trace_sink: %s: write failed: %s (%d)\n", ctx->path,
+            strerror(errno), errno);
+    ctx->error = 1;
+  }
+}
+
+static void *flush_thread(void *ctx_void) {
+  struct trace_sink_ctx *ctx = (struct trace_sink_ctx *)ctx_void;
+
+  pthread_mutex_lock(&ctx->lock);
+  for (;;) {
+    while (!ctx->full_cnt && !ctx->stop) {
+      pthread_cond_wait(&ctx->full_cv, &ctx->lock);
+    }
+    if (!ctx->full_cnt) {
+      break;  // stopped and drained
+    }
+    int idx = ctx->full_q[ctx->full_head];
+    ctx->full_head = (ctx->full_head + 1) % TRACE_SINK_NBUF;
+    ctx->full_cnt--;
+    pthread_mutex_unlock(&ctx->lock);
+
+    sink_write(ctx, ctx->buf[idx], ctx->fill[idx] * sizeof(struct trace_rec));
+
+    pthread_mutex_lock(&ctx->lock);
+    ctx->fill[idx] = 0;
+    ctx->free_q[(ctx->free_head + ctx->free_cnt) % TRACE_SINK_NBUF] = idx;
+    ctx->free_cnt++;
+    pthread_cond_signal(&ctx->free_cv);
+  }
+  pthread_mutex_unlock(&ctx->lock);
+  fflush(ctx->fp);
+  return NULL;
+}
+
+// Hand the current buffer to the flush thread
+static void submit_cur(struct trace_sink_ctx *ctx) {
+  pthread_mutex_lock(&ctx->lock);
+  ctx->full_q[(ctx->full_head + ctx->full_cnt) % TRACE_SINK_NBUF] = ctx->cur;
+  ctx->full_cnt++;
+  ctx->cur = -1;
+  pthread_cond_signal(&ctx->full_cv);
+  pthread_mutex_unlock(&ctx->lock);
+}
+
+// Take a free buffer, waiting for the flush thread if all are in flight
+static void acquire_cur(struct trace_sink_ctx *ctx) {
+  pthread_mutex_lock(&ctx->lock);
+  while (!ctx->free_cnt) {
+    pthread_cond_wait(&ctx->free_cv, &ctx->lock);
+  }
+  ctx->cur = ctx->free_q[ctx->free_head];
+  ctx->free_head = (ctx->free_head + 1) % TRACE_SINK_NBUF;
+  ctx->free_cnt--;
+  pthread_mutex_unlock(&ctx->lock);
+}
+
+static void free_ctx(struct trace_sink_ctx *ctx) {
+  for (int i = 0; i < TRACE_SINK_NBUF; i++) {
+    free(ctx->buf[i]);
+  }
+  free(ctx->zbuf);
+  free(ctx->path);
+  free(ctx);
+}
+
+void *trace_sink_open(const char *path, int compress, int buf_records) {
+  struct trace_sink_ctx *ctx =
+      (struct trace_sink_ctx *)calloc(1, sizeof(struct trace_sink_ctx));
+  struct trace_file_hdr hdr;
+
+  if (!ctx) {
+    return NULL;
+  }
+  ctx->path = strdup(path);
+  ctx->cap = buf_records > 0 ? (size_t)buf_records : TRACE_SINK_DEF_RECORDS;
+  ctx->cur = -1;
+
+#ifdef TRACE_SINK_ZSTD
+  ctx->level = compress;
+  if (ctx->level) {
+    ctx->zcap = ZSTD_compressBound(ctx->cap * sizeof(struct trace_rec));
+    ctx->zbuf = malloc(ctx->zcap);
+  }
+#else
+  if (compress) {
+    fprintf(stderr,
+            "trace_sink: %s: built without TRACE_SINK_ZSTD, writing "
+            "uncompressed\n",
+            path);
+  }
+#endif
+
+  for (int i = 0; i < TRACE_SINK_NBUF; i++) {
+    ctx->buf[i] =
+        (struct trace_rec *)malloc(ctx->cap * sizeof(struct trace_rec));
+    if (!ctx->buf[i]) {
+      fprintf(stderr, "trace_sink: %s: out of memory\n", path);
+      free_ctx(ctx);
+      return NULL;
+    }
+    ctx->free_q[i] = i;
+  }
+  ctx->free_cnt = TRACE_SINK_NBUF;
+
+  ctx->fp = fopen(path, "wb");
+  if (!ctx->fp) {
+    fprintf(stderr, "trace_sink: Unable to open %s: %s (%d)\n", path,
+            strerror(errno), errno);
+    free_ctx(ctx);
+    return NULL;
+  }
+
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, TRACE_FILE_MAGIC, sizeof(hdr.magic));
+  hdr.version = TRACE_FILE_VERSION;
+  hdr.rec_size = sizeof(struct trace_rec);
+  sink_write(ctx, &hdr, sizeof(hdr));
+
+  pthread_mutex_init(&ctx->lock, NULL);
+  pthread_cond_init(&ctx->full_cv, NULL);
+  pthread_cond_init(&ctx->free_cv, NULL);
+  if (pthread_create(&ctx->thread, NULL, flush_thread, (void *)ctx) != 0) {
+    fprintf(stderr, "trace_sink: %s: Unable to create flush thread\n", path);
+    fclose(ctx->fp);
+    free_ctx(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+void trace_sink_put(void *ctx_void, long long cycle, int type, int seq,
+                    int pc, int insn, int rd, int wdata, int csr_addr,
+                    int csr_wdata, int flags, int ecause, int tval) {
+  struct trace_sink_ctx *ctx = (struct trace_sink_ctx *)ctx_void;
+  struct trace_rec *rec;
+
+  if (!ctx) {
+    return;
+  }
+  if (ctx->cur < 0) {
+    acquire_cur(ctx);
+  }
+  rec = &ctx->buf[ctx->cur][ctx->fill[ctx->cur]++];
+  rec->cycle = (uint64_t)cycle;
+  rec->pc = (uint32_t)pc;
+  rec->insn = (uint32_t)insn;
+  rec->wdata = (uint32_t)wdata;
+  rec->csr_wdata = (uint32_t)csr_wdata;
+  rec->tval = (uint32_t)tval;
+  rec->seq = (uint32_t)seq;
+  rec->csr_addr = (uint16_t)csr_addr;
+  rec->rd = (uint8_t)rd;
+  rec->type = (uint8_t)type;
+  rec->flags = (uint8_t)flags;
+  rec->ecause = (uint8_t)ecause;
+  rec->reserved = 0;
+  ctx->records++;
+
+  if (ctx->fill[ctx->cur] == ctx->cap) {
+    submit_cur(ctx);
+  }
+}
+
+void trace_sink_close(void *ctx_void) {
+  struct trace_sink_ctx *ctx = (struct trace_sink_ctx *)ctx_void;
+
+  if (!ctx) {
+    return;
+  }
+  if (ctx->cur >= 0 && ctx->fill[ctx->cur]) {
+    submit_cur(ctx);
+  }
+  pthread_mutex_lock(&ctx->lock);
+  ctx->stop = 1;
+  pthread_cond_signal(&ctx->full_cv);
+  pthread_mutex_unlock(&ctx->lock);
+  pthread_join(ctx->thread, NULL);
+
+  fclose(ctx->fp);
+  fprintf(stderr, "trace_sink: %s: %llu records%s\n", ctx->path,
+          ctx->records, ctx->error ? " (write errors, file incomplete)" : "");
+  pthread_mutex_destroy(&ctx->lock);
+  pthread_cond_destroy(&ctx->full_cv);
+  pthread_cond_destroy(&ctx->free_cv);
+  free_ctx(ctx);
+}
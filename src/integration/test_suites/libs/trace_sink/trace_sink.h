@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALIPTRA_SS_TRACE_SINK_H_
+#define CALIPTRA_SS_TRACE_SINK_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * On-disk format
+ *
+ * A trace file is a trace_file_hdr followed by back-to-back trace_rec
+ * records, all little endian. When written with compression the whole
+ * stream (header included) is a sequence of concatenated zstd frames, one per
+ * flushed buffer, so it can be read back with `zstd -dc` or ZSTD_decompressStream.
+ */
+#define TRACE_FILE_MAGIC    "CSSTRACE"
+#define TRACE_FILE_VERSION  1
+
+struct trace_file_hdr {
+  char     magic[8];     // TRACE_FILE_MAGIC, not NUL terminated
+  uint16_t version;      // TRACE_FILE_VERSION
+  uint16_t rec_size;     // sizeof(struct trace_rec)
+  uint32_t reserved;
+};
+
+// Record types
+#define TRACE_REC_COMMIT    0  // retired instruction
+#define TRACE_REC_NBLOAD    1  // non-blocking load writeback (rd, wdata)
+#define TRACE_REC_DIV       2  // divider writeback (rd, wdata)
+
+// trace_rec.rd
+#define TRACE_RD_MASK       0x1f
+#define TRACE_RD_VALID      0x80  // GPR write, rd != 0
+
+// trace_rec.flags
+#define TRACE_FLAG_CSR      0x01  // CSR write, csr_addr/csr_wdata valid
+#define TRACE_FLAG_EXC      0x02  // exception, ecause/tval valid
+#define TRACE_FLAG_INTR     0x04  // interrupt
+
+struct trace_rec {
+  uint64_t cycle;
+  uint32_t pc;
+  uint32_t insn;
+  uint32_t wdata;
+  uint32_t csr_wdata;
+  uint32_t tval;
+  uint32_t seq;          // commit count, 1 based; 0 for writeback records
+  uint16_t csr_addr;
+  uint8_t  rd;
+  uint8_t  type;
+  uint8_t  flags;
+  uint8_t  ecause;
+  uint16_t reserved;
+};
+
+#ifdef __cplusplus
+static_assert(sizeof(struct trace_rec) == 40, "trace_rec layout changed");
+#else
+_Static_assert(sizeof(struct trace_rec) == 40, "trace_rec layout changed");
+#endif
+
+/**
+ * Open a trace file and start its flush thread
+ *
+ * Call from an initial block.
+ *
+ * @param path        output file name
+ * @param compress    zstd level (1..19), 0 for a raw file. Ignored with a
+ *                    warning unless built with -DTRACE_SINK_ZSTD.
+ * @param buf_records records per buffer, 0 for the default
+ * @return context handle, NULL on error
+ */
+void *trace_sink_open(const char *path, int compress, int buf_records);
+
+/**
+ * Append one record. Only copies into the current buffer; a full buffer is
+ * handed to the flush thread. Blocks only if every buffer is still in flight.
+ */
+void trace_sink_put(void *ctx_void, long long cycle, int type, int seq,
+                    int pc, int insn, int rd, int wdata, int csr_addr,
+                    int csr_wdata, int flags, int ecause, int tval);
+
+/**
+ * Flush outstanding buffers, stop the flush thread and close the file
+ *
+ * Call from a final block.
+ */
+void trace_sink_close(void *ctx_void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // CALIPTRA_SS_TRACE_SINK_H_
@@ -0,0 +1,90 @@
+// Description: Caliptra SS boot latency profile
+// Comments   :
+//  Runs the minimal MCU side of the CSS boot flow (Caliptra BOOT_GO, fuse write
+//  done, BootFSM GO, wait for ready_for_mb_processing) with no console output
+//  until the flow is complete, so firmware printing does not skew the numbers.
+//  css_boot_profiler in the TB timestamps the mci_boot_seqr states and the
+//  Caliptra handshakes; this test adds firmware markers (STDOUT command 0x86,
+//  data[15:8] = marker id) for the steps only software can see:
+//    fw_marker_0 - MCU main() entered
+//    fw_marker_1 - CALIPTRA_BOOT_GO written
+//    fw_marker_2 - ready_for_fuses observed by MCU
+//    fw_marker_3 - BootFSM done/breakpoint observed by MCU
+//    fw_marker_4 - ready_for_mb_processing observed by MCU
+//  Run with +BOOT_PROFILE_BUDGET=<cycles> to fail on boot-time regressions.
+
+#include "soc_address_map.h"
+#include "printf.h"
+#include "riscv_hw_if.h"
+#include "soc_ifc.h"
+#include <string.h>
+#include <stdint.h>
+
+volatile char* stdout = (char *)0x21000410;
+
+#ifdef CPT_VERBOSITY
+    enum printf_verbosity verbosity_g = CPT_VERBOSITY;
+#else
+    enum printf_verbosity verbosity_g = LOW;
+#endif
+
+#define TB_CMD_BOOT_MARKER      0x86
+
+enum boot_marker_e {
+    MARKER_MAIN                 = 0,
+    MARKER_CPTRA_BOOT_GO        = 1,
+    MARKER_READY_FOR_FUSES      = 2,
+    MARKER_BOOT_FSM_DONE        = 3,
+    MARKER_READY_FOR_MB         = 4,
+};
+
+static inline void boot_marker(enum boot_marker_e id) {
+    lsu_write_32((uintptr_t) stdout, ((uint32_t) id << 8) | TB_CMD_BOOT_MARKER);
+}
+
+static inline uint32_t read_mcycle(void) {
+    uint32_t val;
+    __asm__ volatile ("csrr %0, mcycle" : "=r" (val));
+    return val;
+}
+
+void main (void) {
+    enum boot_fsm_state_e boot_fsm_ps;
+    uint32_t t_main, t_done;
+
+    t_main = read_mcycle();
+    boot_marker(MARKER_MAIN);
+
+    // Writing to Caliptra Boot GO register of MCI for CSS BootFSM to bring Caliptra out of reset
+    lsu_write_32(SOC_MCI_REG_CALIPTRA_BOOT_GO, 1);
+    boot_marker(MARKER_CPTRA_BOOT_GO);
+
+    // Wait for ready_for_fuses
+    while(!(lsu_read_32(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) & SOC_IFC_REG_CPTRA_FLOW_STATUS_READY_FOR_FUSES_MASK));
+    boot_marker(MARKER_READY_FOR_FUSES);
+
+    // Initialize fuses
+    lsu_write_32(SOC_SOC_IFC_REG_CPTRA_FUSE_WR_DONE, SOC_IFC_REG_CPTRA_FUSE_WR_DONE_DONE_MASK);
+
+    // Wait for Boot FSM to stall (on breakpoint) or finish bootup
+    do {
+        boot_fsm_ps = (lsu_read_32(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) & SOC_IFC_REG_CPTRA_FLOW_STATUS_BOOT_FSM_PS_MASK) >> SOC_IFC_REG_CPTRA_FLOW_STATUS_BOOT_FSM_PS_LOW;
+    } while(boot_fsm_ps != BOOT_DONE && boot_fsm_ps != BOOT_WAIT);
+    boot_marker(MARKER_BOOT_FSM_DONE);
+
+    // Advance from breakpoint, if set
+    if (boot_fsm_ps == BOOT_WAIT) {
+        lsu_write_32(SOC_SOC_IFC_REG_CPTRA_BOOTFSM_GO, SOC_IFC_REG_CPTRA_BOOTFSM_GO_GO_MASK);
+    }
+
+    // Wait for ready_for_mb_processing
+    while(!(lsu_read_32(SOC_SOC_IFC_REG_CPTRA_FLOW_STATUS) & SOC_IFC_REG_CPTRA_FLOW_STATUS_READY_FOR_MB_PROCESSING_MASK));
+    boot_marker(MARKER_READY_FOR_MB);
+    t_done = read_mcycle();
+
+    VPRINTF(LOW, "=================\nMCU Caliptra SS Boot Profile\n=================\n\n")
+    VPRINTF(LOW, "MCU: main() to ready_for_mb_processing in %d MCU cycles\n", t_done - t_main);
+    VPRINTF(LOW, "MCU: Boot FSM %s\n", boot_fsm_ps == BOOT_WAIT ? "stopped at breakpoint" : "ran through");
+
+    SEND_STDOUT_CTRL(0xff);
+}
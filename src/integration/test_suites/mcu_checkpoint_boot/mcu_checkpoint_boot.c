@@ -0,0 +1,47 @@
+// Description: Post-boot checkpoint for fast test turnaround
+// Comments   :
+//  Runs the CSS boot flow up to ready_for_mb_processing once, then asks the TB
+//  to fork the simulation (STDOUT command 0x8B) for each test directory listed
+//  in +CHECKPOINT_TESTS=<file>. Every forked test requests an MCU reset, during
+//  which the TB loads that test's own mcu_program.elf, so the test starts with
+//  Caliptra already booted. Tests that boot Caliptra with css_cptra_boot()
+//  (libs/css_boot) skip their boot sequence when MCI
+//  RESET_REASON.FW_BOOT_UPD_RESET is set.
+//  Without +CHECKPOINT_TESTS the MCU resets into this same image, which passes
+//  once it sees FW_BOOT_UPD_RESET.
+
+#include "soc_address_map.h"
+#include "printf.h"
+#include "riscv_hw_if.h"
+#include "soc_ifc.h"
+#include "css_boot.h"
+#include <string.h>
+#include <stdint.h>
+
+volatile char* stdout = (char *)0x21000410;
+
+#ifdef CPT_VERBOSITY
+    enum printf_verbosity verbosity_g = CPT_VERBOSITY;
+#else
+    enum printf_verbosity verbosity_g = LOW;
+#endif
+
+#define TB_CMD_FW_EXEC_LOCK     0x8A
+#define TB_CMD_CHECKPOINT       0x8B
+
+void main (void) {
+    VPRINTF(LOW, "=================\nMCU Caliptra SS Checkpoint Boot\n=================\n\n")
+
+    if (css_cptra_boot()) {
+        SEND_STDOUT_CTRL(0xff);
+    }
+    VPRINTF(LOW, "MCU: Caliptra ready for mailbox processing, checkpoint\n");
+
+    // The TB only forks with +CHECKPOINT_TESTS. Either way the MCU is reset
+    // next: into the test firmware in a forked test, or back into this image.
+    // No Caliptra FW sets the exec region lock the reset waits for.
+    lsu_write_32((uintptr_t) stdout, TB_CMD_CHECKPOINT);
+    lsu_write_32((uintptr_t) stdout, (1 << 8) | TB_CMD_FW_EXEC_LOCK);
+    lsu_write_32(SOC_MCI_REG_RESET_REQUEST, MCI_REG_RESET_REQUEST_MCU_REQ_MASK);
+    while (1);
+}
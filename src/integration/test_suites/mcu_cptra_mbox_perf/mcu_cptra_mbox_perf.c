@@ -0,0 +1,124 @@
+// Description: MCU to Caliptra mailbox throughput benchmark
+// Comments   :
+//  Brings Caliptra up the same way as mcu_cptra_bringup, then sends the
+//  0xFADECAFE command through the Caliptra mailbox with DLEN swept from 4 bytes
+//  to the full mailbox (doubling each step), BENCH_MBOX_ITERATIONS times per
+//  size. Each transfer is split into phases timed with mcycle:
+//    lock   - MBOX_LOCK read until the lock is granted
+//    datain - CMD, DLEN and DLEN/4 DATAIN writes
+//    exec   - EXECUTE write until STATUS reports DATA_READY
+//    drain  - response DLEN and DATAOUT reads, then EXECUTE clear (release)
+//  Results are printed as CSV between the 0x88/0x89 STDOUT commands, which the
+//  TB copies to mcu_bench.csv.
+
+#include "soc_address_map.h"
+#include "printf.h"
+#include "riscv_hw_if.h"
+#include "soc_ifc.h"
+#include "css_boot.h"
+#include <string.h>
+#include <stdint.h>
+
+volatile char* stdout = (char *)0x21000410;
+
+#ifdef CPT_VERBOSITY
+    enum printf_verbosity verbosity_g = CPT_VERBOSITY;
+#else
+    enum printf_verbosity verbosity_g = LOW;
+#endif
+
+// Caliptra mailbox SRAM size, override with -DBENCH_MBOX_SIZE_BYTES=...
+#ifndef BENCH_MBOX_SIZE_BYTES
+#define BENCH_MBOX_SIZE_BYTES   (256*1024)
+#endif
+#ifndef BENCH_MBOX_ITERATIONS
+#define BENCH_MBOX_ITERATIONS   2
+#endif
+#define BENCH_MBOX_MIN_DLEN     4
+
+static inline uint32_t read_mcycle(void) {
+    uint32_t val;
+    __asm__ volatile ("csrr %0, mcycle" : "=r" (val));
+    return val;
+}
+
+static void cptra_bringup(void) {
+    css_cptra_boot();
+
+    // MBOX: Setup valid AXI USER
+    lsu_write_32(SOC_SOC_IFC_REG_CPTRA_MBOX_VALID_AXI_USER_0, 0xffffffff);
+    lsu_write_32(SOC_SOC_IFC_REG_CPTRA_MBOX_AXI_USER_LOCK_0, SOC_IFC_REG_CPTRA_MBOX_AXI_USER_LOCK_0_LOCK_MASK);
+    VPRINTF(LOW, "MCU: Configured MBOX Valid AXI USER\n");
+}
+
+// One complete mailbox transaction; returns 0 on success
+static int mbox_transfer(uint32_t dlen, uint32_t iter) {
+    uint32_t t_start, t_lock, t_datain, t_exec, t_drain;
+    uint32_t resp_dlen;
+    uint32_t resp_data;
+    uint32_t status;
+
+    // MBOX: Acquire lock
+    t_start = read_mcycle();
+    while((lsu_read_32(SOC_MBOX_CSR_MBOX_LOCK) & MBOX_CSR_MBOX_LOCK_LOCK_MASK));
+    t_lock = read_mcycle();
+
+    // MBOX: Write CMD, DLEN and datain
+    lsu_write_32(SOC_MBOX_CSR_MBOX_CMD, 0xFADECAFE | MBOX_CMD_FIELD_RESP_MASK); // Resp required
+    lsu_write_32(SOC_MBOX_CSR_MBOX_DLEN, dlen);
+    for (uint32_t ii = 0; ii < dlen/4; ii++) {
+        lsu_write_32(SOC_MBOX_CSR_MBOX_DATAIN, ii ^ iter);
+    }
+    t_datain = read_mcycle();
+
+    // MBOX: Execute and poll status
+    // No sleep loop in the poll, so the measured time is not quantized by it
+    lsu_write_32(SOC_MBOX_CSR_MBOX_EXECUTE, MBOX_CSR_MBOX_EXECUTE_EXECUTE_MASK);
+    do {
+        status = (lsu_read_32(SOC_MBOX_CSR_MBOX_STATUS) & MBOX_CSR_MBOX_STATUS_STATUS_MASK) >> MBOX_CSR_MBOX_STATUS_STATUS_LOW;
+    } while (status != DATA_READY && status != CMD_FAILURE);
+    t_exec = read_mcycle();
+    if (status == CMD_FAILURE) {
+        VPRINTF(ERROR, "MCU: Mbox command failed, dlen %d iter %d\n", dlen, iter);
+        lsu_write_32(SOC_MBOX_CSR_MBOX_EXECUTE, 0);
+        return 1;
+    }
+
+    // MBOX: Read response and release the mailbox
+    resp_dlen = lsu_read_32(SOC_MBOX_CSR_MBOX_DLEN);
+    for (uint32_t ii = 0; ii < (resp_dlen/4 + (resp_dlen%4 ? 1 : 0)); ii++) {
+        resp_data = lsu_read_32(SOC_MBOX_CSR_MBOX_DATAOUT);
+    }
+    lsu_write_32(SOC_MBOX_CSR_MBOX_EXECUTE, 0);
+    t_drain = read_mcycle();
+
+    // dlen,iter,resp_dlen,lock,datain,exec,drain,total
+    VPRINTF(LOW, "%d,%d,%d,%d,%d,%d,%d,%d\n", dlen, iter, resp_dlen,
+            t_lock - t_start, t_datain - t_lock, t_exec - t_datain, t_drain - t_exec, t_drain - t_start);
+    return 0;
+}
+
+void main (void) {
+    int err = 0;
+
+    VPRINTF(LOW, "=================\nMCU Caliptra Mailbox Throughput\n=================\n\n")
+
+    cptra_bringup();
+
+    VPRINTF(LOW, "MCU: DLEN sweep %d..%d bytes, %d iterations\n", BENCH_MBOX_MIN_DLEN, BENCH_MBOX_SIZE_BYTES, BENCH_MBOX_ITERATIONS);
+    SEND_STDOUT_CTRL(0x88);
+    VPRINTF(LOW, "dlen,iter,resp_dlen,lock,datain,exec,drain,total\n");
+    for (uint32_t dlen = BENCH_MBOX_MIN_DLEN; dlen <= BENCH_MBOX_SIZE_BYTES && !err; dlen <<= 1) {
+        for (uint32_t iter = 0; iter < BENCH_MBOX_ITERATIONS && !err; iter++) {
+            err |= mbox_transfer(dlen, iter);
+        }
+    }
+    SEND_STDOUT_CTRL(0x89);
+
+    if (err) {
+        SEND_STDOUT_CTRL(0x1);
+    }
+    else {
+        SEND_STDOUT_CTRL(0xff);
+    }
+}
@@ -0,0 +1,268 @@
+// Description: MCU interrupt latency benchmark
+// Comments   :
+//  Measures the MCU response time from a TB-driven external interrupt line to
+//  the vectored handler, through the VeeR PIC gateway, arbitration and the
+//  fast-interrupt-redirect path (meivt table in DCCM).
+//  The TB lines only reach the PIC with +MCU_EXT_INT_TB, which the test yml
+//  passes through the Makefile.
+//  The TB timestamps every line it raises (STDOUT command 0x81); the handler
+//  samples mcycle on entry and reports it back with command 0x84. The TB
+//  monitor (mcu_intr_latency_mon) computes the latency and prints the
+//  min/avg/max per vector and per priority level at the end of simulation.
+//  Three sweeps are run:
+//   1. every TB-drivable PIC vector at a fixed priority
+//   2. every priority level on a single vector
+//   3. nesting: a higher priority source must preempt a running handler,
+//      an equal priority source must not
+
+#include "soc_address_map.h"
+#include "printf.h"
+#include "riscv_hw_if.h"
+#include <stdint.h>
+
+volatile char* stdout = (char *)0x21000410;
+
+#ifdef CPT_VERBOSITY
+    enum printf_verbosity verbosity_g = CPT_VERBOSITY;
+#else
+    enum printf_verbosity verbosity_g = LOW;
+#endif
+
+// ---- VeeR EL2 PIC (css_mcu0 configuration) ----
+#define MCU_PIC_BASE_ADDR           0x60000000
+#define MCU_PIC_MEIPL(S)            (MCU_PIC_BASE_ADDR + 0x0000 + (S)*4)
+#define MCU_PIC_MEIP(X)             (MCU_PIC_BASE_ADDR + 0x1000 + ((X)>>5)*4)
+#define MCU_PIC_MEIE(S)             (MCU_PIC_BASE_ADDR + 0x2000 + (S)*4)
+#define MCU_PIC_MPICCFG             (MCU_PIC_BASE_ADDR + 0x3000)
+#define MCU_PIC_MEIGWCTRL(S)        (MCU_PIC_BASE_ADDR + 0x4000 + (S)*4)
+#define MCU_PIC_MEIGWCLR(S)         (MCU_PIC_BASE_ADDR + 0x5000 + (S)*4)
+#define MCU_PIC_TOTAL_INT           255
+#define MCU_PIC_MEIGWCTRL_LEVEL_HI  0x0
+
+#define VEER_CSR_MEIVT              0xBC8
+#define VEER_CSR_MEIPT              0xBC9
+#define VEER_CSR_MEICIDPL           0xBCB
+#define VEER_CSR_MEICURPL           0xBCC
+#define VEER_CSR_MEIHAP             0xFC8
+
+#define MSTATUS_MIE_BIT_MASK        0x00000008
+#define MSTATUS_MPIE_MPP_BIT_MASK   0x00001880
+#define MIE_MEI_BIT_MASK            0x00000800
+
+// ---- TB interrupt commands (see caliptra_ss_top_tb console monitor) ----
+#define TB_CMD_CLR_EXT_INT          0x80
+#define TB_CMD_SET_EXT_INT          0x81
+#define TB_CMD_ISR_ENTRY            0x84
+#define TB_CMD_ISR_EXIT             0x85
+
+// Vectors 1..4 are driven inside caliptra_ss_top (MCI, mailbox, I3C, fuse ctrl)
+// and the TB only drives lines below PIC_TOTAL_INT
+#define BENCH_FIRST_VEC             5
+#define BENCH_LAST_VEC              (MCU_PIC_TOTAL_INT - 1)
+#define BENCH_VEC_PRIO              8
+#define BENCH_PRIO_ITERATIONS       4
+#define BENCH_TIMEOUT               100000
+// Time the outer handler keeps interrupts open for a nested source to preempt
+#define BENCH_NEST_WINDOW_CYCLES    2000
+
+#define csr_read(csr, val)  __asm__ volatile ("csrr %0, %1" : "=r" (val) : "i" (csr))
+#define csr_write(csr, val) __asm__ volatile ("csrw %0, %1" : : "i" (csr), "r" (val))
+
+static void latency_isr(void) __attribute__ ((interrupt ("machine"), aligned(4)));
+
+// Every vector routes to the same handler, which recovers the claim ID from meihap.
+// Must be in DCCM and 1024-byte aligned for fast interrupt redirect.
+static void (* __attribute__ ((aligned(4))) latency_vector_table [MCU_PIC_TOTAL_INT+1]) (void) __attribute__ ((aligned(1024),section (".dccm"))) = {
+    [0 ... MCU_PIC_TOTAL_INT] = latency_isr
+};
+
+volatile uint32_t isr_count;
+volatile uint32_t isr_last_vec;
+volatile uint32_t nest_outer_vec;
+volatile uint32_t nest_inner_vec;
+volatile uint32_t nest_inner_taken;
+
+static inline void tb_cmd(uint8_t cmd, uint8_t vec, uint16_t arg) {
+    lsu_write_32((uintptr_t) stdout, ((uint32_t) arg << 16) | ((uint32_t) vec << 8) | cmd);
+}
+
+static inline uint32_t read_mcycle(void) {
+    uint32_t val;
+    __asm__ volatile ("csrr %0, mcycle" : "=r" (val));
+    return val;
+}
+
+static void latency_isr(void) {
+    uint32_t entry_mcycle = read_mcycle();
+    uint32_t meihap;
+    uint32_t vec;
+
+    csr_read(VEER_CSR_MEIHAP, meihap);
+    vec = (meihap >> 2) & 0xFF;
+    tb_cmd(TB_CMD_ISR_ENTRY, vec, entry_mcycle);
+
+    if (vec == nest_outer_vec) {
+        uint32_t meicidpl;
+        uint32_t prev_meicurpl;
+        uint32_t prev_mepc;
+        uint32_t prev_mstatus;
+        uint32_t start;
+
+        // Open a nesting window at the current priority, as production
+        // handlers do, and raise the inner source from inside it
+        csr_read(VEER_CSR_MEICIDPL, meicidpl);
+        csr_read(VEER_CSR_MEICURPL, prev_meicurpl);
+        __asm__ volatile ("csrr %0, mepc"    : "=r" (prev_mepc));
+        __asm__ volatile ("csrr %0, mstatus" : "=r" (prev_mstatus));
+        csr_write(VEER_CSR_MEICURPL, meicidpl);
+        __asm__ volatile ("csrs mstatus, %0" : : "r" (MSTATUS_MIE_BIT_MASK));
+
+        tb_cmd(TB_CMD_SET_EXT_INT, nest_inner_vec, 0);
+        start = read_mcycle();
+        while (isr_last_vec != nest_inner_vec && (read_mcycle() - start) < BENCH_NEST_WINDOW_CYCLES);
+        nest_inner_taken = (isr_last_vec == nest_inner_vec);
+
+        __asm__ volatile ("csrc mstatus, %0" : : "r" (MSTATUS_MIE_BIT_MASK));
+        csr_write(VEER_CSR_MEICURPL, prev_meicurpl);
+        __asm__ volatile ("csrw mepc, %0"    : : "r" (prev_mepc));
+        __asm__ volatile ("csrs mstatus, %0" : : "r" (prev_mstatus & MSTATUS_MPIE_MPP_BIT_MASK));
+    }
+
+    // Drop the line and wait for the level-triggered gateway to follow,
+    // otherwise mret would re-enter this handler
+    tb_cmd(TB_CMD_CLR_EXT_INT, vec, 0);
+    while (lsu_read_32(MCU_PIC_MEIP(vec)) & (1 << (vec & 0x1F)));
+
+    tb_cmd(TB_CMD_ISR_EXIT, vec, 0);
+    isr_last_vec = vec;
+    isr_count++;
+}
+
+static void pic_init(void) {
+    uint32_t zero = 0;
+
+    __asm__ volatile ("csrc mstatus, %0" : : "r" (MSTATUS_MIE_BIT_MASK));
+
+    csr_write(VEER_CSR_MEIVT, (uint32_t) latency_vector_table);
+    lsu_write_32(MCU_PIC_MPICCFG, 0); // Standard priority order: 0=lowest,15=highest
+    csr_write(VEER_CSR_MEIPT,    zero);
+    csr_write(VEER_CSR_MEICIDPL, zero);
+    csr_write(VEER_CSR_MEICURPL, zero);
+
+    // Everything starts disabled; each measurement enables only its own sources
+    for (uint32_t vec = 1; vec <= MCU_PIC_TOTAL_INT; vec++) {
+        lsu_write_32(MCU_PIC_MEIPL(vec),     0);
+        lsu_write_32(MCU_PIC_MEIGWCTRL(vec), MCU_PIC_MEIGWCTRL_LEVEL_HI);
+        lsu_write_32(MCU_PIC_MEIGWCLR(vec),  0);
+        lsu_write_32(MCU_PIC_MEIE(vec),      0);
+    }
+    __asm__ volatile ("fence");
+
+    __asm__ volatile ("csrs mie, %0"     : : "r" (MIE_MEI_BIT_MASK));
+    __asm__ volatile ("csrs mstatus, %0" : : "r" (MSTATUS_MIE_BIT_MASK));
+}
+
+static void pic_enable(uint32_t vec, uint32_t prio) {
+    lsu_write_32(MCU_PIC_MEIPL(vec), prio);
+    lsu_write_32(MCU_PIC_MEIE(vec),  1);
+    __asm__ volatile ("fence");
+}
+
+static void pic_disable(uint32_t vec) {
+    lsu_write_32(MCU_PIC_MEIE(vec),  0);
+    lsu_write_32(MCU_PIC_MEIPL(vec), 0);
+    __asm__ volatile ("fence");
+}
+
+// Returns 0 once isr_count reaches 'count', 1 on timeout
+static int wait_isr_count(uint32_t count) {
+    for (uint32_t i = 0; i < BENCH_TIMEOUT; i++) {
+        if (isr_count >= count) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int bench_vector(uint32_t vec, uint32_t prio, uint32_t iterations) {
+    int err = 0;
+    pic_enable(vec, prio);
+    for (uint32_t i = 0; i < iterations && !err; i++) {
+        uint32_t expected = isr_count + 1;
+        tb_cmd(TB_CMD_SET_EXT_INT, vec, 0);
+        if (wait_isr_count(expected) || isr_last_vec != vec) {
+            VPRINTF(ERROR, "MCU: vector %d (prio %d) not serviced\n", vec, prio);
+            err = 1;
+        }
+    }
+    pic_disable(vec);
+    return err;
+}
+
+static int bench_nest(uint32_t outer_prio, uint32_t inner_prio) {
+    const uint32_t outer = BENCH_FIRST_VEC;
+    const uint32_t inner = BENCH_FIRST_VEC + 1;
+    uint32_t expected = isr_count + 2;
+    uint32_t expect_preempt = inner_prio > outer_prio;
+    int err = 0;
+
+    nest_outer_vec   = outer;
+    nest_inner_vec   = inner;
+    nest_inner_taken = 0;
+    isr_last_vec     = 0;
+    pic_enable(outer, outer_prio);
+    pic_enable(inner, inner_prio);
+
+    tb_cmd(TB_CMD_SET_EXT_INT, outer, 0);
+    if (wait_isr_count(expected)) {
+        VPRINTF(ERROR, "MCU: nesting %d/%d timed out\n", outer_prio, inner_prio);
+        err = 1;
+    }
+    else if (nest_inner_taken != expect_preempt) {
+        VPRINTF(ERROR, "MCU: prio %d %s prio %d\n", inner_prio,
+                nest_inner_taken ? "preempted" : "did not preempt", outer_prio);
+        err = 1;
+    }
+
+    nest_outer_vec = 0;
+    nest_inner_vec = 0;
+    pic_disable(outer);
+    pic_disable(inner);
+    return err;
+}
+
+void main (void) {
+    int err = 0;
+
+    VPRINTF(LOW, "=================\nMCU Interrupt Latency\n=================\n\n")
+
+    isr_count      = 0;
+    isr_last_vec   = 0;
+    nest_outer_vec = 0;
+    nest_inner_vec = 0;
+    pic_init();
+
+    VPRINTF(LOW, "MCU: vectors %d..%d at prio %d\n", BENCH_FIRST_VEC, BENCH_LAST_VEC, BENCH_VEC_PRIO);
+    for (uint32_t vec = BENCH_FIRST_VEC; vec <= BENCH_LAST_VEC && !err; vec++) {
+        err |= bench_vector(vec, BENCH_VEC_PRIO, 1);
+    }
+
+    VPRINTF(LOW, "MCU: priority levels 1..15 on vector %d\n", BENCH_FIRST_VEC);
+    for (uint32_t prio = 1; prio <= 15 && !err; prio++) {
+        err |= bench_vector(BENCH_FIRST_VEC, prio, BENCH_PRIO_ITERATIONS);
+    }
+
+    VPRINTF(LOW, "MCU: nesting\n");
+    for (uint32_t prio = 1; prio < 15 && !err; prio++) {
+        err |= bench_nest(prio, prio + 1); // must preempt
+        err |= bench_nest(prio, prio);     // must not preempt
+    }
+
+    VPRINTF(LOW, "MCU: %d interrupts serviced\n", isr_count);
+    if (err) {
+        SEND_STDOUT_CTRL(0x1);
+    }
+    else {
+        SEND_STDOUT_CTRL(0xff);
+    }
+}
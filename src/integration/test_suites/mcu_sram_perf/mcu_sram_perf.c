@@ -0,0 +1,230 @@
+// Description: MCU SRAM bandwidth and latency benchmark
+// Comments   :
+//  Times accesses through mci_mcu_sram_ctrl with mcycle:
+//    pattern     - sequential, or strided by BENCH_SRAM_STRIDE bytes (wrapping
+//                  so every element of the buffer is still touched once)
+//    granularity - byte, half and word; sub-word writes go through the ECC
+//                  read-modify-write path of the SRAM controller
+//    region      - execution region vs protected data region; the boundary is
+//                  moved with FW_SRAM_EXEC_REGION_SIZE so both buffers sit
+//                  above the firmware .data/.bss
+//    requestor   - mcu_lsu: exec region with the fw exec region lock clear
+//                           (region "exec_unlocked"), then exec and prot
+//                           regions with the lock forced by the TB (STDOUT
+//                           command 0x8A). All of these are MCU LSU accesses;
+//                           no Caliptra traffic is generated.
+//                  mcu_ifu: a straight-line kernel copied into the exec region
+//                           and executed (cold and warm), against the same
+//                           kernel run from ROM as a baseline
+//  Written data is checked after every write pass. Results are printed as CSV
+//  between the 0x88/0x89 STDOUT commands, which the TB copies to mcu_bench.csv.
+//  Cycle ratios are fixed point: cyc_per_acc is x100, bytes_per_cyc is x1000.
+
+#include "soc_address_map.h"
+#include "printf.h"
+#include "riscv_hw_if.h"
+#include <string.h>
+#include <stdint.h>
+
+volatile char* stdout = (char *)0x21000410;
+
+#ifdef CPT_VERBOSITY
+    enum printf_verbosity verbosity_g = CPT_VERBOSITY;
+#else
+    enum printf_verbosity verbosity_g = LOW;
+#endif
+
+// Bytes touched per pass and stride of the strided pattern, override with -D
+#ifndef BENCH_SRAM_BYTES
+#define BENCH_SRAM_BYTES        1024
+#endif
+#ifndef BENCH_SRAM_STRIDE
+#define BENCH_SRAM_STRIDE       64
+#endif
+
+#define MCU_SRAM_BASE_ADDR      (SOC_MCI_REG_BASE_ADDR + 0x200000)
+// FW_SRAM_EXEC_REGION_SIZE is in 4KB steps with 0 being 4KB: 0x20 -> [0, 132KB)
+#define BENCH_EXEC_REGION_SIZE  0x20
+#define BENCH_EXEC_BUF_ADDR     (MCU_SRAM_BASE_ADDR + 0x20000)
+#define BENCH_PROT_BUF_ADDR     (MCU_SRAM_BASE_ADDR + 0x30000)
+#define BENCH_IFU_BUF_ADDR      (MCU_SRAM_BASE_ADDR + 0x1F000)
+
+#define TB_CMD_EXEC_LOCK        0x8A
+
+#define BENCH_IFU_KERNEL_INSNS  128
+
+enum bench_op_e { BENCH_RD = 0, BENCH_WR = 1 };
+
+static const char *const op_str[] = { "rd", "wr" };
+
+// Straight-line kernel for the IFU measurement: a0 += BENCH_IFU_KERNEL_INSNS.
+// Uncompressed and position independent so it can be copied into MCU SRAM.
+__asm__ (
+    "    .section .text.sram_ifu_kernel, \"ax\"\n"
+    "    .option push\n"
+    "    .option norvc\n"
+    "    .balign 4\n"
+    "    .global sram_ifu_kernel\n"
+    "sram_ifu_kernel:\n"
+    "    .rept 128\n"
+    "    addi a0, a0, 1\n"
+    "    .endr\n"
+    "    ret\n"
+    "    .global sram_ifu_kernel_end\n"
+    "sram_ifu_kernel_end:\n"
+    "    .option pop\n"
+    "    .text\n"
+);
+extern uint32_t sram_ifu_kernel(uint32_t);
+extern char sram_ifu_kernel_end[];
+
+static volatile uint32_t sink;
+
+static inline uint32_t read_mcycle(void) {
+    uint32_t val;
+    __asm__ volatile ("csrr %0, mcycle" : "=r" (val));
+    return val;
+}
+
+static inline void tb_cmd(uint8_t cmd, uint8_t arg) {
+    lsu_write_32((uintptr_t) stdout, ((uint32_t) arg << 8) | cmd);
+}
+
+// One timed pass per access width. The strided walk visits offsets
+// off, off+stride, ... for every off < stride, so the access count matches
+// the sequential pass.
+#define SRAM_BENCH_PASS(type)                                                          \
+static uint32_t sram_pass_##type(uintptr_t base, uint32_t stride, int op, type pat) {  \
+    uint32_t t_start, acc = 0;                                                         \
+    t_start = read_mcycle();                                                           \
+    for (uint32_t off = 0; off < stride; off += sizeof(type)) {                        \
+        for (uint32_t a = off; a < BENCH_SRAM_BYTES; a += stride) {                    \
+            volatile type *p = (volatile type *) (base + a);                           \
+            if (op == BENCH_WR) *p = pat;                                              \
+            else                acc += *p;                                             \
+        }                                                                              \
+    }                                                                                  \
+    t_start = read_mcycle() - t_start;                                                 \
+    sink = acc;                                                                        \
+    return t_start;                                                                    \
+}
+SRAM_BENCH_PASS(uint8_t)
+SRAM_BENCH_PASS(uint16_t)
+SRAM_BENCH_PASS(uint32_t)
+
+static void report(const char *req, const char *region, const char *pattern, const char *op,
+                   uint32_t size, uint32_t accesses, uint32_t cycles) {
+    // requestor,region,pattern,op,size,accesses,cycles,cyc_per_acc,bytes_per_cyc
+    VPRINTF(LOW, "%s,%s,%s,%s,%d,%d,%d,%d,%d\n", req, region, pattern, op, size, accesses, cycles,
+            (cycles * 100) / accesses, (accesses * size * 1000) / cycles);
+}
+
+// Word-wise readback of a buffer filled with a replicated pattern
+static int sram_check(uintptr_t base, uint32_t exp) {
+    for (uint32_t a = 0; a < BENCH_SRAM_BYTES; a += 4) {
+        uint32_t got = lsu_read_32(base + a);
+        if (got != exp) {
+            VPRINTF(ERROR, "MCU: SRAM mismatch at 0x%x: 0x%x, expected 0x%x\n", base + a, got, exp);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// All granularities and patterns for one buffer. Each write pass uses a new
+// replicated pattern so a read-modify-write that clobbers neighbouring bytes
+// shows up in the check.
+static int sram_bench_region(const char *req, const char *region, uintptr_t base) {
+    static const uint32_t sizes[] = { 4, 2, 1 };
+    uint32_t pat = 0x3C96E187;
+    uint32_t cycles;
+    int err = 0;
+
+    for (int pattern = 0; pattern < 2; pattern++) {
+        for (int s = 0; s < 3; s++) {
+            uint32_t size     = sizes[s];
+            uint32_t stride   = pattern ? BENCH_SRAM_STRIDE : size;
+            uint32_t accesses = BENCH_SRAM_BYTES / size;
+            uint32_t exp;
+            for (int op = BENCH_WR; op >= BENCH_RD; op--) {
+                switch (size) {
+                    case 1:  cycles = sram_pass_uint8_t (base, stride, op, (uint8_t)  pat); exp = (pat & 0xff) * 0x01010101; break;
+                    case 2:  cycles = sram_pass_uint16_t(base, stride, op, (uint16_t) pat); exp = (pat & 0xffff) * 0x00010001; break;
+                    default: cycles = sram_pass_uint32_t(base, stride, op, pat);            exp = pat; break;
+                }
+                report(req, region, pattern ? "stride" : "seq", op_str[op], size, accesses, cycles);
+                if (op == BENCH_WR) err |= sram_check(base, exp);
+            }
+            pat = (pat << 7) ^ (pat >> 3) ^ 0xA5A5A5A5;
+        }
+    }
+    return err;
+}
+
+// Time the IFU kernel once from ROM and twice (cold, warm) from the exec region
+static int sram_bench_ifu(void) {
+    uint32_t (*kernel)(uint32_t) = (uint32_t (*)(uint32_t)) BENCH_IFU_BUF_ADDR;
+    uint32_t kernel_bytes = (uint32_t) (sram_ifu_kernel_end - (char *) sram_ifu_kernel);
+    uint32_t t_start, cycles, ret;
+    int err = 0;
+
+    for (uint32_t a = 0; a < kernel_bytes; a += 4) {
+        lsu_write_32(BENCH_IFU_BUF_ADDR + a, *(uint32_t *) ((uintptr_t) sram_ifu_kernel + a));
+    }
+    __asm__ volatile ("fence.i");
+
+    t_start = read_mcycle();
+    ret = sram_ifu_kernel(0);
+    cycles = read_mcycle() - t_start;
+    report("mcu_ifu", "rom", "seq", "fetch", 4, BENCH_IFU_KERNEL_INSNS, cycles);
+    err |= (ret != BENCH_IFU_KERNEL_INSNS);
+
+    for (int pass = 0; pass < 2; pass++) {
+        t_start = read_mcycle();
+        ret = kernel(0);
+        cycles = read_mcycle() - t_start;
+        report("mcu_ifu", pass ? "exec_warm" : "exec_cold", "seq", "fetch", 4, BENCH_IFU_KERNEL_INSNS, cycles);
+        err |= (ret != BENCH_IFU_KERNEL_INSNS);
+    }
+    if (err) {
+        VPRINTF(ERROR, "MCU: IFU kernel returned %d, expected %d\n", ret, BENCH_IFU_KERNEL_INSNS);
+    }
+    return err;
+}
+
+void main (void) {
+    int err = 0;
+
+    VPRINTF(LOW, "=================\nMCU SRAM Bandwidth and Latency\n=================\n\n")
+
+    // Move the exec/prot boundary above the firmware data so both buffers are usable
+    lsu_write_32(SOC_MCI_REG_FW_SRAM_EXEC_REGION_SIZE, BENCH_EXEC_REGION_SIZE);
+    VPRINTF(LOW, "MCU: %d bytes per pass, stride %d, exec buf 0x%x, prot buf 0x%x\n",
+            BENCH_SRAM_BYTES, BENCH_SRAM_STRIDE, BENCH_EXEC_BUF_ADDR, BENCH_PROT_BUF_ADDR);
+
+    SEND_STDOUT_CTRL(0x88);
+    VPRINTF(LOW, "requestor,region,pattern,op,size,accesses,cycles,cyc_per_acc,bytes_per_cyc\n");
+
+    // Lock clear: MCU LSU accesses to the exec region before the lock is set.
+    // Must run first, the MCU access grant is sticky until the next MCU reset.
+    err |= sram_bench_region("mcu_lsu", "exec_unlocked", BENCH_EXEC_BUF_ADDR);
+
+    // Lock set: exec region belongs to MCU, allow for the 2-flop sync in MCI
+    tb_cmd(TB_CMD_EXEC_LOCK, 1);
+    for (uint8_t ii = 0; ii < 16; ii++) {
+        __asm__ volatile ("nop");
+    }
+    err |= sram_bench_region("mcu_lsu", "exec", BENCH_EXEC_BUF_ADDR);
+    err |= sram_bench_region("mcu_lsu", "prot", BENCH_PROT_BUF_ADDR);
+    err |= sram_bench_ifu();
+
+    SEND_STDOUT_CTRL(0x89);
+    tb_cmd(TB_CMD_EXEC_LOCK, 0);
+
+    if (err) {
+        SEND_STDOUT_CTRL(0x1);
+    }
+    else {
+        SEND_STDOUT_CTRL(0xff);
+    }
+}
@@ -11,7 +11,39 @@ module caliptra_ss_sram #(
   output logic [DATA_WIDTH-1:0]      rdata_o
 );
 
+`ifdef TB_SPARSE_MEM
+  // Storage in sparse_mem.c, only pages that were written take host memory.
+  // Backdoor access goes through handle()/read()/write().
+  import sparse_mem_pkg::*;
 
+  chandle mem;
+
+  // Lazily created, so TB initial blocks can use it before ours has run
+  function automatic chandle handle();
+    if (mem == null) mem = sparse_mem_new($sformatf("%m"), DEPTH, DATA_WIDTH, 0, 8'h00);
+    return mem;
+  endfunction
+
+  function automatic logic [DATA_WIDTH-1:0] read(input longint unsigned idx);
+    return DATA_WIDTH'(sparse_mem_read(handle(), idx));
+  endfunction
+
+  function automatic void write(input longint unsigned idx, input logic [DATA_WIDTH-1:0] data);
+    sparse_mem_write(handle(), idx, 64'(data));
+  endfunction
+
+  initial void'(handle());
+  final sparse_mem_free(mem);
+
+  always @(posedge clk_i) begin
+    if (cs_i & we_i) begin
+      sparse_mem_write(mem, addr_i, 64'(wdata_i));
+    end
+    if (cs_i & ~we_i) begin
+      rdata_o <= DATA_WIDTH'(sparse_mem_read(mem, addr_i));
+    end
+  end
+`else
   bit [ DATA_WIDTH-1:0] ram[0:DEPTH-1];
 
   always @(posedge clk_i) begin
@@ -22,5 +54,6 @@ module caliptra_ss_sram #(
       rdata_o <= ram[addr_i];
     end
   end
+`endif
 
 endmodule
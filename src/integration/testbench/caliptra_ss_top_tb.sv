@@ -31,14 +31,23 @@ module caliptra_ss_top_tb
 );
 
     import tb_top_pkg::*;
+`ifdef AVERY_AXI_INTERCONNECT
     import aaxi_pkg::*;
+`endif
     import axi_pkg::*;
     import soc_ifc_pkg::*;
     import caliptra_top_tb_pkg::*;
+`ifdef AVERY_I3C
     import ai2c_pkg::*;
     import ai3c_pkg::*;
     import avery_pkg_test::*;
+`endif
     import jtag_pkg::*;
+    import elf_loader_pkg::*;
+    import ecc_preload_pkg::*;
+    import checkpoint_pkg::*;
+    import console_mon_pkg::*;
+    import mem_dump_pkg::*;
 
 `ifndef VERILATOR
     // Time formatting for %t in display tasks
@@ -59,6 +68,10 @@ module caliptra_ss_top_tb
     localparam MCU_SRAM_DATA_TOTAL_WIDTH = MCU_SRAM_DATA_WIDTH + MCU_SRAM_ECC_WIDTH;
     localparam MCU_SRAM_DEPTH   = (MCU_SRAM_SIZE_KB * 1024) / MCU_SRAM_DATA_WIDTH_BYTES;
     localparam MCU_SRAM_ADDR_WIDTH = $clog2(MCU_SRAM_DEPTH);
+    // Firmware addresses of the TB memory models, see load_mcu_elf
+    localparam longint MCU_SRAM_BASE = 32'h2120_0000;
+    localparam longint MCU_ROM_BASE  = 32'h8000_0000;
+    localparam longint MCU_ROM_SIZE  = 16'h7FFF * 8;
 
 
     bit                         core_clk;
@@ -382,7 +395,10 @@ module caliptra_ss_top_tb
     
     tb_top_pkg::veer_sram_error_injection_mode_t error_injection_mode;
 
+    `define MCU_TOP caliptra_ss_dut.rvtop_wrapper
     `define MCU_DEC caliptra_ss_dut.rvtop_wrapper.rvtop.veer.dec
+    `define MCU_PIC caliptra_ss_dut.rvtop_wrapper.rvtop.veer.pic_ctrl_inst
+    `define CPTRA_DEC caliptra_ss_dut.caliptra_top_dut.rvtop.veer.dec
 
 
     assign mailbox_write    = caliptra_ss_dut.mci_top_i.s_axi_w_if.awvalid && (caliptra_ss_dut.mci_top_i.s_axi_w_if.awaddr == mem_mailbox) && rst_l;
@@ -392,23 +408,97 @@ module caliptra_ss_top_tb
 
     parameter MAX_CYCLES = 200_000;
     bit       hex_file_is_empty;
+    string    mcu_elf;
+    chandle   mcu_elf_ctx;
 
     integer fd, tp, el;
+    chandle console;
+    bit     text_trace_en;
+    bit     bin_trace_en;
+    integer bench_fd = 0;
+    bit     bench_csv_en;
+    string  checkpoint_tests;
+    int     checkpoint_jobs;
 
     always @(negedge core_clk) begin
-        // console Monitor
+        // console Monitor, buffered in console_mon.c; echoed a line at a time
         if( mailbox_data_val & mailbox_write) begin
-            $fwrite(fd,"%c", mailbox_data[7:0]);
-            $write("%c", mailbox_data[7:0]);
-            if (mailbox_data[7:0] inside {8'h0A,8'h0D}) begin // CR/LF
-                $fflush(fd);
+            if (console_mon_putc(console, cycleCnt, mailbox_data[7:0]))
+                $write("%s", console_mon_line(console));
+            if (bench_csv_en) $fwrite(bench_fd,"%c", mailbox_data[7:0]);
+        end
+        // Command bytes go to the event log (mcu_events.jsonl)
+        if (mailbox_write && !mailbox_data_val) begin
+            console_mon_event(console, cycleCnt, mailbox_data);
+        end
+        // Benchmark CSV capture
+        // data[7:0] == 0x88 - start copying console output to mcu_bench.csv
+        // data[7:0] == 0x89 - stop copying console output to mcu_bench.csv
+        if(mailbox_write && (mailbox_data[7:0] == 8'h88)) begin
+            if (!bench_fd) bench_fd = $fopen("mcu_bench.csv","w");
+            bench_csv_en = 1'b1;
+        end
+        if(mailbox_write && (mailbox_data[7:0] == 8'h89) && bench_csv_en) begin
+            bench_csv_en = 1'b0;
+            $fflush(bench_fd);
+        end
+        // MCU SRAM exec region lock override
+        // data[7:0] == 0x8A - data[8] = 1: force mcu_sram_fw_exec_region_lock (normally set by Caliptra FW)
+        //                     data[8] = 0: release the override
+        if(mailbox_write && (mailbox_data[7:0] == 8'h8A)) begin
+            if (mailbox_data[8]) begin
+                $display("[%0d] Forcing MCU SRAM fw exec region lock", cycleCnt);
+                force caliptra_ss_dut.mci_top_i.mcu_sram_fw_exec_region_lock = 1'b1;
+            end
+            else begin
+                $display("[%0d] Releasing MCU SRAM fw exec region lock", cycleCnt);
+                release caliptra_ss_dut.mci_top_i.mcu_sram_fw_exec_region_lock;
+            end
+        end
+        // Post-boot checkpoint
+        // data[7:0] == 0x8B - fork the simulation once per test in +CHECKPOINT_TESTS,
+        //                     each test then reloads its own firmware on the next MCU reset
+        if(mailbox_write && (mailbox_data[7:0] == 8'h8B)) begin
+            if (checkpoint_tests == "") begin
+                $display("[%0d] Checkpoint requested without +CHECKPOINT_TESTS, ignored", cycleCnt);
+            end
+            else begin
+                $display("[%0d] Checkpoint reached, forking tests listed in %s", cycleCnt, checkpoint_tests);
+                console_mon_flush(console);
+                case (checkpoint_fork(checkpoint_tests, checkpoint_jobs))
+                    1: checkpoint_resume();
+                    // Checkpoint process, all forked tests have finished
+                    0: begin
+                        $display("* TESTCASE PASSED");
+                        $finish;
+                    end
+                    2: begin
+                        $error("* TESTCASE FAILED");
+                        $finish;
+                    end
+                    default: begin
+                        $error("Checkpoint fork failed");
+                        $finish;
+                    end
+                endcase
             end
         end
+        // TB memory snapshot
+        // data[7:0] == 0x8C - dump memory data[15:8] (0: DCCM, 1: MCU SRAM, 2: MCU ROM)
+        //                     to a file, data[16] = 1: binary, 0: hex
+        if(mailbox_write && (mailbox_data[7:0] == 8'h8C)) begin
+            snapshot_mem(mailbox_data[15:8], mailbox_data[16]);
+        end
+        // data[7:0] == 0x8D - start the I3C recovery image stream, handled by css_i3c_ctrl
+        // data[7:0] == 0x8E - waveform dump on (data[8] = 1) or off, handled by css_wave_ctl
         // Interrupt signals control
         // data[7:0] == 0x80 - clear ext irq line index given by data[15:8]
         // data[7:0] == 0x81 - set ext irq line index given by data[15:8]
         // data[7:0] == 0x82 - clean NMI, timer and soft irq lines to bits data[8:10]
         // data[7:0] == 0x83 - set NMI, timer and soft irq lines to bits data[8:10]
+        // data[7:0] == 0x84 - ISR entry timestamp, handled by mcu_intr_latency_mon
+        // data[7:0] == 0x85 - ISR exit, handled by mcu_intr_latency_mon
+        // data[7:0] == 0x86 - firmware boot milestone data[15:8], handled by css_boot_profiler
         // data[7:0] == 0x90 - clear all interrupt request signals
         if(mailbox_write && (mailbox_data[7:0] >= 8'h80 && mailbox_data[7:0] < 8'h84)) begin
             if (mailbox_data[7:0] == 8'h80) begin
@@ -464,10 +554,13 @@ module caliptra_ss_top_tb
                 dump_signature();
             end
             // End Of test monitor
-            else if(mailbox_data[7:0] == 8'hff) begin
+            if(mailbox_data[7:0] == 8'hff) begin
                 $display("* TESTCASE PASSED");
                 $display("\nFinished : minstret = %0d, mcycle = %0d", `MCU_DEC.tlu.minstretl[31:0],`MCU_DEC.tlu.mcyclel[31:0]);
-                $display("See \"mcu_exec.log\" for execution trace with register updates..\n");
+                if (text_trace_en)
+                    $display("See \"mcu_exec.log\" for execution trace with register updates..\n");
+                else if (bin_trace_en)
+                    $display("See \"mcu_trace.bin\" for the binary execution trace, +TEXT_TRACE for mcu_exec.log..\n");
                 if($test$plusargs("AVY_TEST")) begin
                     $display("Waiting 500us for I3C tests to finish..\n");
                     #500us;
@@ -476,12 +569,25 @@ module caliptra_ss_top_tb
             end
             else if(mailbox_data[7:0] == 8'h1) begin
                 $error("* TESTCASE FAILED");
+                // Post-mortem state of all TB memories
+                if ($test$plusargs("MEM_SNAPSHOT_ON_FAIL")) begin
+                    for (int r = 0; r < 3; r++) snapshot_mem(r, 1'b1);
+                end
                 $finish;
             end
         end
     end
 
 
+    final console_mon_close(console);
+
+`ifdef VERILATOR
+    // Speed report of the Verilator harness (test_caliptra_ss_top_tb.cpp)
+    import "DPI-C" function void tb_sim_stats(input int cycles, input int instret);
+
+    final tb_sim_stats(cycleCnt, `MCU_DEC.tlu.minstretl[31:0]);
+`endif
+
     // trace monitor
     always @(posedge core_clk) begin
         wb_valid      <= `MCU_DEC.dec_i0_wen_r;
@@ -490,7 +596,7 @@ module caliptra_ss_top_tb
         wb_csr_valid  <= `MCU_DEC.dec_csr_wen_r;
         wb_csr_dest   <= `MCU_DEC.dec_csr_wraddr_r;
         wb_csr_data   <= `MCU_DEC.dec_csr_wrdata_r;
-        if (trace_rv_i_valid_ip) begin
+        if (trace_rv_i_valid_ip && text_trace_en) begin
            $fwrite(tp,"%b,%h,%h,%0h,%0h,3,%b,%h,%h,%b\n", trace_rv_i_valid_ip, 0, trace_rv_i_address_ip,
                   0, trace_rv_i_insn_ip,trace_rv_i_exception_ip,trace_rv_i_ecause_ip,
                   trace_rv_i_tval_ip,trace_rv_i_interrupt_ip);
@@ -505,15 +611,45 @@ module caliptra_ss_top_tb
                    );
         end
         if(`MCU_DEC.dec_nonblock_load_wen) begin
-            $fwrite (el, "%10d : %32s=%h                ; nbL\n", cycleCnt, abi_reg[`MCU_DEC.dec_nonblock_load_waddr], `MCU_DEC.lsu_nonblock_load_data);
+            if (text_trace_en)
+                $fwrite (el, "%10d : %32s=%h                ; nbL\n", cycleCnt, abi_reg[`MCU_DEC.dec_nonblock_load_waddr], `MCU_DEC.lsu_nonblock_load_data);
             caliptra_ss_top_tb.gpr[0][`MCU_DEC.dec_nonblock_load_waddr] = `MCU_DEC.lsu_nonblock_load_data;
         end
         if(`MCU_DEC.exu_div_wren) begin
-            $fwrite (el, "%10d : %32s=%h                ; nbD\n", cycleCnt, abi_reg[`MCU_DEC.div_waddr_wb], `MCU_DEC.exu_div_result);
+            if (text_trace_en)
+                $fwrite (el, "%10d : %32s=%h                ; nbD\n", cycleCnt, abi_reg[`MCU_DEC.div_waddr_wb], `MCU_DEC.exu_div_result);
             caliptra_ss_top_tb.gpr[0][`MCU_DEC.div_waddr_wb] = `MCU_DEC.exu_div_result;
         end
     end
 
+    // binary trace
+    trace_sink #(
+        .FileName       ("mcu_trace.bin")
+    ) mcu_trace_sink (
+        .clk_i          (core_clk),
+        .en_i           (bin_trace_en),
+        .cycle_i        (cycleCnt),
+        .commit_i       (trace_rv_i_valid_ip),
+        .pc_i           (trace_rv_i_address_ip),
+        .insn_i         (trace_rv_i_insn_ip),
+        .rd_wen_i       (wb_valid),
+        .rd_i           (wb_dest),
+        .rd_wdata_i     (wb_data),
+        .csr_wen_i      (wb_csr_valid),
+        .csr_addr_i     (wb_csr_dest),
+        .csr_wdata_i    (wb_csr_data),
+        .exception_i    (trace_rv_i_exception_ip),
+        .interrupt_i    (trace_rv_i_interrupt_ip),
+        .ecause_i       (trace_rv_i_ecause_ip),
+        .tval_i         (trace_rv_i_tval_ip),
+        .nbload_wen_i   (`MCU_DEC.dec_nonblock_load_wen),
+        .nbload_rd_i    (`MCU_DEC.dec_nonblock_load_waddr),
+        .nbload_wdata_i (`MCU_DEC.lsu_nonblock_load_data),
+        .div_wen_i      (`MCU_DEC.exu_div_wren),
+        .div_rd_i       (`MCU_DEC.div_waddr_wb),
+        .div_wdata_i    (`MCU_DEC.exu_div_result)
+    );
+
 
     initial begin
         abi_reg[0] = "zero";
@@ -552,21 +688,55 @@ module caliptra_ss_top_tb
         ext_int_tb  = {pt.PIC_TOTAL_INT-1{1'b0}};
         timer_int   = 0;
 
-        hex_file_is_empty = $system("test -s mcu_lmem.hex");
-        if (!hex_file_is_empty) $readmemh("mcu_lmem.hex",lmem_dummy_preloader.ram); // FIXME - should there bit a limit like Caliptra has for iccm.hex?
+        // Firmware images come straight from the ELF (+MCU_ELF=<path>, default
+        // mcu_program.elf). The padded objcopy hex files are only used when no
+        // ELF is present, e.g. for pre-built images.
+        if (!$value$plusargs("MCU_ELF=%s", mcu_elf)) mcu_elf = "mcu_program.elf";
+        mcu_elf_ctx = null;
+        fd = $fopen(mcu_elf, "rb");
+        if (fd != 0) begin
+            $fclose(fd);
+            mcu_elf_ctx = elf_loader_open(mcu_elf);
+            if (mcu_elf_ctx == null) begin
+                $error("Unable to load MCU firmware ELF %s", mcu_elf);
+                $finish;
+            end
+        end
 
+        if (mcu_elf_ctx != null) begin
+            load_mcu_elf();
+        end
+        else begin
+            hex_file_is_empty = $system("test -s mcu_lmem.hex");
+            if (!hex_file_is_empty) $readmemh("mcu_lmem.hex",lmem_dummy_preloader.ram); // FIXME - should there bit a limit like Caliptra has for iccm.hex?
 
-        $readmemh("mcu_program.hex",  imem.ram);
+            $readmemh("mcu_program.hex",  imem.ram);
 
-        tp = $fopen("trace_port.csv","w");
-        el = $fopen("mcu_exec.log","w");
-        $fwrite (el, "//   Cycle : #inst    0    pc    opcode    reg=value    csr=value     ; mnemonic\n");
-        fd = $fopen("mcu_console.log","w");
-        commit_count = 0;
+            css_mcu0_dummy_dccm_preloader.ram = '{default:8'h0};
+            hex_file_is_empty = $system("test -s mcu_dccm.hex");
+            if (!hex_file_is_empty) $readmemh("mcu_dccm.hex",css_mcu0_dummy_dccm_preloader.ram,0,32'h0001_FFFF);
+        end
 
-        css_mcu0_dummy_dccm_preloader.ram = '{default:8'h0};
-        hex_file_is_empty = $system("test -s mcu_dccm.hex");
-        if (!hex_file_is_empty) $readmemh("mcu_dccm.hex",css_mcu0_dummy_dccm_preloader.ram,0,32'h0001_FFFF);
+        // Memory signature written to veer.signature at end of test
+        void'($value$plusargs("SIGNATURE_BEGIN=%h", mem_signature_begin));
+        void'($value$plusargs("SIGNATURE_END=%h", mem_signature_end));
+
+        // With +CHECKPOINT_TESTS=<file> the traces only start in the forked
+        // tests (checkpoint_resume), which also keeps the trace writer thread
+        // from running before the fork
+        if (!$value$plusargs("CHECKPOINT_TESTS=%s", checkpoint_tests)) checkpoint_tests = "";
+        if (!$value$plusargs("CHECKPOINT_JOBS=%d", checkpoint_jobs)) checkpoint_jobs = 1;
+        // Text traces format every retired instruction in the simulator and
+        // are slow on long runs; the binary trace (mcu_trace.bin) is the default
+        text_trace_en = $test$plusargs("TEXT_TRACE") && checkpoint_tests == "";
+        bin_trace_en  = !$test$plusargs("NO_BIN_TRACE") && checkpoint_tests == "";
+        if (text_trace_en) begin
+            tp = $fopen("trace_port.csv","w");
+            el = $fopen("mcu_exec.log","w");
+            $fwrite (el, "//   Cycle : #inst    0    pc    opcode    reg=value    csr=value     ; mnemonic\n");
+        end
+        console = open_console();
+        commit_count = 0;
 
         // preload_dccm();
         preload_css_mcu0_dccm();
@@ -593,10 +763,23 @@ module caliptra_ss_top_tb
    // AXI Interconnect
    //=========================================================================
 
+`ifdef AVERY_AXI_INTERCONNECT
+    localparam AXI_INTC_ADDR_WIDTH = aaxi_pkg::AAXI_ADDR_WIDTH;
+
     aaxi4_interconnect axi_interconnect(
         .core_clk (core_clk),
         .rst_l    (rst_l)
     );
+`else
+    // Open source crossbar with the same ports and address map, see
+    // css_axi_xbar.sv
+    localparam AXI_INTC_ADDR_WIDTH = 64;
+
+    css_axi_xbar #(.AW(AXI_INTC_ADDR_WIDTH)) axi_interconnect(
+        .core_clk (core_clk),
+        .rst_l    (rst_l)
+    );
+`endif
 
     // AXI Interface
     axi_if #(
@@ -758,12 +941,14 @@ module caliptra_ss_top_tb
 
     // AXI Interconnect connections
     always_comb begin
-        axi_interconnect.mintf_arr[0].ARADDR[aaxi_pkg::AAXI_ADDR_WIDTH-1:32] = 32'h0;
-        axi_interconnect.mintf_arr[0].AWADDR[aaxi_pkg::AAXI_ADDR_WIDTH-1:32] = 32'h0;
-        axi_interconnect.mintf_arr[1].ARADDR[aaxi_pkg::AAXI_ADDR_WIDTH-1:32] = 32'h0;
-        axi_interconnect.mintf_arr[1].AWADDR[aaxi_pkg::AAXI_ADDR_WIDTH-1:32] = 32'h0;
-        axi_interconnect.sintf_arr[2].ARADDR[aaxi_pkg::AAXI_ADDR_WIDTH-1:32] = 32'h0;
-        axi_interconnect.sintf_arr[2].AWADDR[aaxi_pkg::AAXI_ADDR_WIDTH-1:32] = 32'h0;
+        axi_interconnect.mintf_arr[0].ARADDR[AXI_INTC_ADDR_WIDTH-1:32] = 32'h0;
+        axi_interconnect.mintf_arr[0].AWADDR[AXI_INTC_ADDR_WIDTH-1:32] = 32'h0;
+        axi_interconnect.mintf_arr[1].ARADDR[AXI_INTC_ADDR_WIDTH-1:32] = 32'h0;
+        axi_interconnect.mintf_arr[1].AWADDR[AXI_INTC_ADDR_WIDTH-1:32] = 32'h0;
+`ifdef AVERY_AXI_INTERCONNECT
+        axi_interconnect.sintf_arr[2].ARADDR[AXI_INTC_ADDR_WIDTH-1:32] = 32'h0;
+        axi_interconnect.sintf_arr[2].AWADDR[AXI_INTC_ADDR_WIDTH-1:32] = 32'h0;
+`endif
 
         // Slave port 0 disconnection.
         axi_interconnect.sintf_arr[0].ARREADY = 1'b0;
@@ -1314,6 +1499,191 @@ module caliptra_ss_top_tb
         .jtag_srst_n    ()
     );
 
+    //=========================================================================-
+    // TB driven MCU external interrupts
+    //=========================================================================-
+    // With +MCU_EXT_INT_TB, ext_int_tb (STDOUT commands 0x80/0x81/0x90) is
+    // merged with the interrupt sources driven inside caliptra_ss_top before
+    // reaching the PIC. Other tests keep the DUT connection untouched.
+    assign ext_int = caliptra_ss_dut.ext_int | ext_int_tb;
+    initial if ($test$plusargs("MCU_EXT_INT_TB")) force `MCU_TOP.extintsrc_req = ext_int;
+
+    mcu_intr_latency_mon #(
+        .TOTAL_INT      (pt.PIC_TOTAL_INT)
+    ) mcu_intr_latency_mon (
+        .clk            (core_clk),
+        .rst_l          (rst_l),
+        .cycleCnt       (cycleCnt),
+        .mailbox_write  (mailbox_write),
+        .mailbox_data   (mailbox_data[31:0]),
+        .ext_int_tb     (ext_int_tb),
+        .mcycle         (`MCU_DEC.tlu.mcyclel[31:0]),
+        .intpriority    (`MCU_PIC.intpriority_reg)
+    );
+
+    //=========================================================================-
+    // Boot milestone profiler
+    //=========================================================================-
+    css_boot_profiler css_boot_profiler (
+        .clk                     (core_clk),
+        .rst_l                   (rst_l),
+        .cycleCnt                (cycleCnt),
+        .mailbox_write           (mailbox_write),
+        .mailbox_data            (mailbox_data[31:0]),
+        .boot_fsm                (caliptra_ss_dut.mci_top_i.i_boot_seqr.boot_fsm),
+        .ready_for_fuses         (ready_for_fuses),
+        .ready_for_mb_processing (ready_for_mb_processing),
+        .cptra_awvalid           (cptra_ss_cptra_core_s_axi_if.awvalid),
+        .cptra_awready           (cptra_ss_cptra_core_s_axi_if.awready),
+        .cptra_awaddr            (cptra_ss_cptra_core_s_axi_if.awaddr[31:0]),
+        .cptra_wvalid            (cptra_ss_cptra_core_s_axi_if.wvalid),
+        .cptra_wready            (cptra_ss_cptra_core_s_axi_if.wready),
+        .cptra_wdata             (cptra_ss_cptra_core_s_axi_if.wdata[31:0])
+    );
+
+    //=========================================================================-
+    // MCU hang detector
+    //=========================================================================-
+    mcu_hang_mon mcu_hang_mon (
+        .clk            (core_clk),
+        .rst_l          (rst_l),
+        .mcu_rst_b      (caliptra_ss_dut.mci_top_i.mcu_rst_b),
+        .cycleCnt       (cycleCnt),
+        .commit         (trace_rv_i_valid_ip),
+        .pc             (trace_rv_i_address_ip),
+        .insn           (trace_rv_i_insn_ip),
+        .exception      (trace_rv_i_exception_ip),
+        .interrupt      (trace_rv_i_interrupt_ip),
+        .lsu_awvalid    (cptra_ss_mcu_lsu_m_axi_if.awvalid),
+        .lsu_awready    (cptra_ss_mcu_lsu_m_axi_if.awready),
+        .lsu_awaddr     (cptra_ss_mcu_lsu_m_axi_if.awaddr[31:0]),
+        .lsu_bvalid     (cptra_ss_mcu_lsu_m_axi_if.bvalid),
+        .lsu_bready     (cptra_ss_mcu_lsu_m_axi_if.bready),
+        .lsu_arvalid    (cptra_ss_mcu_lsu_m_axi_if.arvalid),
+        .lsu_arready    (cptra_ss_mcu_lsu_m_axi_if.arready),
+        .lsu_araddr     (cptra_ss_mcu_lsu_m_axi_if.araddr[31:0]),
+        .lsu_rvalid     (cptra_ss_mcu_lsu_m_axi_if.rvalid),
+        .lsu_rready     (cptra_ss_mcu_lsu_m_axi_if.rready),
+        .lsu_rlast      (cptra_ss_mcu_lsu_m_axi_if.rlast),
+        .lsu_rdata      (cptra_ss_mcu_lsu_m_axi_if.rdata),
+        .ifu_arvalid    (cptra_ss_mcu_ifu_m_axi_if.arvalid),
+        .ifu_arready    (cptra_ss_mcu_ifu_m_axi_if.arready),
+        .ifu_araddr     (cptra_ss_mcu_ifu_m_axi_if.araddr[31:0]),
+        .ifu_rvalid     (cptra_ss_mcu_ifu_m_axi_if.rvalid),
+        .ifu_rready     (cptra_ss_mcu_ifu_m_axi_if.rready),
+        .ifu_rlast      (cptra_ss_mcu_ifu_m_axi_if.rlast)
+    );
+
+    //=========================================================================-
+    // Simulation speed telemetry
+    //=========================================================================-
+    css_sim_telemetry css_sim_telemetry (
+        .clk                     (core_clk),
+        .rst_l                   (rst_l),
+        .cycleCnt                (cycleCnt),
+        .mailbox_write           (mailbox_write),
+        .mailbox_data            (mailbox_data[31:0]),
+        .mcu_rst_b               (caliptra_ss_dut.mci_top_i.mcu_rst_b),
+`ifdef CALIPTRA_CORE_TLM
+        .cptra_rst_b             (caliptra_ss_dut.mcu_cptra_rst_b),
+        .ready_for_mb_processing (ready_for_mb_processing),
+        .mcu_instret             (`MCU_DEC.tlu.minstretl[31:0]),
+        .cptra_instret           (32'h0)
+`else
+        .cptra_rst_b             (caliptra_ss_dut.caliptra_top_dut.cptra_uc_rst_b),
+        .ready_for_mb_processing (ready_for_mb_processing),
+        .mcu_instret             (`MCU_DEC.tlu.minstretl[31:0]),
+        .cptra_instret           (`CPTRA_DEC.tlu.minstretl[31:0])
+`endif
+    );
+
+    //=========================================================================-
+    // Functional coverage counters
+    //=========================================================================-
+    css_func_cov css_func_cov (
+        .clk                     (core_clk),
+        .rst_l                   (rst_l),
+        .mailbox_write           (mailbox_write),
+        .mailbox_data            (mailbox_data[31:0]),
+        .boot_fsm                (caliptra_ss_dut.mci_top_i.i_boot_seqr.boot_fsm),
+`ifdef CSS_STUB_FC_LCC
+        .lc_state                (lc_ctrl_state_pkg::DecLcStRaw),
+        .lc_target               (lc_ctrl_state_pkg::DecLcStRaw),
+        .lc_trans_cmd            (1'b0),
+        .lc_trans_success        (1'b0),
+        .fuse_dai_wr             (1'b0),
+        .fuse_dai_part           (8'h0),
+`else
+        .lc_state                (caliptra_ss_dut.u_lc_ctrl.dec_lc_state[0]),
+        .lc_target               (caliptra_ss_dut.u_lc_ctrl.transition_target_q[0]),
+        .lc_trans_cmd            (caliptra_ss_dut.u_lc_ctrl.transition_cmd),
+        .lc_trans_success        (caliptra_ss_dut.u_lc_ctrl.trans_success_q),
+        .fuse_dai_wr             (caliptra_ss_dut.u_otp_ctrl.u_otp_ctrl_dai.otp_req_o &&
+                                  caliptra_ss_dut.u_otp_ctrl.u_otp_ctrl_dai.otp_gnt_i &&
+                                  caliptra_ss_dut.u_otp_ctrl.u_otp_ctrl_dai.otp_cmd_o inside {caliptra_prim_otp_pkg::Write,
+                                                                                             caliptra_prim_otp_pkg::WriteRaw}),
+        .fuse_dai_part           (8'(caliptra_ss_dut.u_otp_ctrl.u_otp_ctrl_dai.part_idx)),
+`endif
+        .cptra_awvalid           (cptra_ss_cptra_core_s_axi_if.awvalid),
+        .cptra_awready           (cptra_ss_cptra_core_s_axi_if.awready),
+        .cptra_awaddr            (cptra_ss_cptra_core_s_axi_if.awaddr[31:0]),
+        .cptra_wvalid            (cptra_ss_cptra_core_s_axi_if.wvalid),
+        .cptra_wready            (cptra_ss_cptra_core_s_axi_if.wready),
+        .cptra_wdata             (cptra_ss_cptra_core_s_axi_if.wdata[31:0]),
+        .mci_awvalid             (caliptra_ss_dut.mci_top_i.s_axi_w_if.awvalid),
+        .mci_awready             (caliptra_ss_dut.mci_top_i.s_axi_w_if.awready),
+        .mci_awaddr              (caliptra_ss_dut.mci_top_i.s_axi_w_if.awaddr[31:0]),
+        .mci_wvalid              (caliptra_ss_dut.mci_top_i.s_axi_w_if.wvalid),
+        .mci_wready              (caliptra_ss_dut.mci_top_i.s_axi_w_if.wready),
+        .mci_wdata               (caliptra_ss_dut.mci_top_i.s_axi_w_if.wdata[31:0])
+    );
+
+    // Waveform dump triggers, see css_wave_ctl.sv. The signal condition is a
+    // build time expression, e.g. +define+WAVE_COND=caliptra_ss_dut.mci_top_i.mcu_rst_b
+`ifndef WAVE_COND
+    `define WAVE_COND 1'b0
+`endif
+    logic wave_dump_en;
+    logic wave_dump_en_d = 1'b0;
+
+    css_wave_ctl css_wave_ctl (
+        .clk            (core_clk),
+        .rst_l          (rst_l),
+        .cycleCnt       (cycleCnt),
+        .mailbox_write  (mailbox_write),
+        .mailbox_data   (mailbox_data[31:0]),
+        .commit         (trace_rv_i_valid_ip),
+        .pc             (trace_rv_i_address_ip),
+        .cond           (`WAVE_COND),
+        .dump_en        (wave_dump_en)
+    );
+
+`ifdef VERILATOR
+    // Dump control of the Verilator harness: 0 off, 1 on, 2 test passed
+    import "DPI-C" function void tb_wave_ctl(input int cmd);
+
+    always @(posedge core_clk) begin
+        wave_dump_en_d <= wave_dump_en;
+        if (wave_dump_en != wave_dump_en_d) tb_wave_ctl(int'(wave_dump_en));
+        if (mailbox_write && mailbox_data[7:0] == 8'hff) tb_wave_ctl(2);
+    end
+`else
+    bit wave_dump_started;
+
+    always @(posedge core_clk) begin
+        wave_dump_en_d <= wave_dump_en;
+        if ($test$plusargs("dumpon") && wave_dump_en != wave_dump_en_d) begin
+            if (wave_dump_en && !wave_dump_started) begin
+                wave_dump_started = 1'b1;
+                $dumpfile("sim.vcd");
+                $dumpvars(0, caliptra_ss_top_tb);
+            end
+            else if (wave_dump_en) $dumpon;
+            else                   $dumpoff;
+        end
+    end
+`endif
+
 
 
 `ifdef CALIPTRA_INTERNAL_TRNG
@@ -1331,6 +1701,22 @@ module caliptra_ss_top_tb
     //=========================================================================-
     // Services for SRAM exports, STDOUT, etc
     //=========================================================================-
+`ifdef CALIPTRA_CORE_TLM
+    // The services reach into the Caliptra core, which the stand-in does not
+    // have. Nothing uses its SRAMs; the SoC BFM flags stay idle.
+    assign cptra_ss_cptra_core_mbox_sram_rdata_i = '0;
+    assign cptra_ss_cptra_core_imem_rdata_i      = '0;
+    assign ras_test_ctrl                         = '0;
+    assign int_flag                              = 1'b0;
+    assign cycleCnt_smpl_en                      = 1'b0;
+    assign assert_hard_rst_flag                  = 1'b0;
+    assign deassert_hard_rst_flag                = 1'b0;
+    assign assert_rst_flag_from_service          = 1'b0;
+    assign deassert_rst_flag_from_service        = 1'b0;
+    assign cptra_uds_rand                        = '0;
+    assign cptra_fe_rand                         = '0;
+    assign cptra_obf_key_tb                      = '0;
+`else
     caliptra_top_tb_services #(
         .UVM_TB(0)
     ) tb_services_i (
@@ -1382,6 +1768,7 @@ module caliptra_ss_top_tb
     );
 
     caliptra_top_sva sva();
+`endif
 
     //=========================================================================-
     // AXI MEM instance : IMEM
@@ -1427,8 +1814,10 @@ module caliptra_ss_top_tb
     //     .bid            (axi_interconnect.sintf_arr[0].BID)
 
     // );
-    assign axi_interconnect.sintf_arr[0].ARADDR[aaxi_pkg::AAXI_ADDR_WIDTH-1:32] = 32'h0;
-    assign axi_interconnect.sintf_arr[0].AWADDR[aaxi_pkg::AAXI_ADDR_WIDTH-1:32] = 32'h0;
+`ifdef AVERY_AXI_INTERCONNECT
+    assign axi_interconnect.sintf_arr[0].ARADDR[AXI_INTC_ADDR_WIDTH-1:32] = 32'h0;
+    assign axi_interconnect.sintf_arr[0].AWADDR[AXI_INTC_ADDR_WIDTH-1:32] = 32'h0;
+`endif
 
     assign cptra_ss_mcu_rom_s_axi_if.awvalid                      = axi_interconnect.sintf_arr[2].AWVALID;
     assign cptra_ss_mcu_rom_s_axi_if.awaddr                       = axi_interconnect.sintf_arr[2].AWADDR[31:0];
@@ -1555,6 +1944,7 @@ module caliptra_ss_top_tb
         .lc_clk_byp_ack_i(cptra_ss_lc_clk_byp_ack_i)
     );
 
+`ifndef CSS_STUB_FC_LCC
 `ifdef LCC_FC_BFM_SIM
     always_comb begin
         if (!lcc_bfm_reset) begin
@@ -1578,11 +1968,16 @@ module caliptra_ss_top_tb
         if (cptra_ss_otp_core_axi_rd_req_i.arvalid && cptra_ss_otp_core_axi_rd_rsp_o.arready && cptra_ss_otp_core_axi_rd_req_i.araddr == 32'h7000_0084)
             release caliptra_ss_dut.u_otp_ctrl.u_fuse_ctrl_filter.core_axi_wr_req.awuser;
     end
+`endif
 `endif
 
     //--------------------------------------------------------------------------------------------
 
+`ifdef CSS_STUB_FC_LCC
+    assign lcc_to_mci_lc_done = caliptra_ss_dut.lcc_to_mci_lc_done;
+`else
     assign lcc_to_mci_lc_done = pwrmgr_pkg::pwr_lc_rsp_t'(caliptra_ss_dut.u_lc_ctrl.pwr_lc_o.lc_done);
+`endif
     assign lcc_init_req.lc_init = mci_to_lcc_init_req; 
 
 
@@ -1593,10 +1988,22 @@ module caliptra_ss_top_tb
         .lc_dft_en_i         (),
         .lc_escalate_en_i    (),
         .lc_check_byp_en_i   (),
+`ifdef CSS_STUB_FC_LCC
+        .otp_lc_data_o (),
+`else
         .otp_lc_data_o (caliptra_ss_dut.u_otp_ctrl.otp_lc_data_o),
+`endif
         .fuse_ctrl_rdy       (fuse_ctrl_rdy       )
     );
 
+`ifdef DIGITAL_IO_I3C
+    wire cptra_ss_sel_od_pp_o;
+`else
+    wire cptra_ss_i3c_scl_io;
+    wire cptra_ss_i3c_sda_io;
+`endif
+
+`ifdef AVERY_I3C
     // --- I3C env and interface ---
     ai3c_env i3c_env0;
     wand  SCL;
@@ -1618,13 +2025,6 @@ module caliptra_ss_top_tb
     logic [31:0] i3c_axi_wdata_32; // FIXME
     logic [3:0]  i3c_axi_wstrb_4; // FIXME
 
-    `ifdef DIGITAL_IO_I3C
-        wire cptra_ss_sel_od_pp_o;
-    `else
-        wire cptra_ss_i3c_scl_io;
-        wire cptra_ss_i3c_sda_io;
-    `endif
-
     initial begin
         // --- Avery I3C slave ---
         // slave = new("slave", , AI3C_SLAVE, slave_intf);
@@ -1654,6 +2054,40 @@ module caliptra_ss_top_tb
             ai3c_run_test("ai3ct_ext_basic", i3c_env0); 
         end
     end
+`else
+    // --- I3C controller, see css_i3c_ctrl.sv ---
+    logic i3c_ctrl_scl_o;
+    logic i3c_ctrl_sda_o;
+    logic i3c_scl;
+    logic i3c_sda;
+
+    `ifdef DIGITAL_IO_I3C
+        logic cptra_ss_i3c_scl_o;
+        logic cptra_ss_i3c_sda_o;
+
+        assign i3c_scl = i3c_ctrl_scl_o & cptra_ss_i3c_scl_o;
+        assign i3c_sda = i3c_ctrl_sda_o & cptra_ss_i3c_sda_o;
+    `else
+        pullup (cptra_ss_i3c_scl_io);
+        pullup (cptra_ss_i3c_sda_io);
+        assign cptra_ss_i3c_scl_io = i3c_ctrl_scl_o ? 1'bz : 1'b0;
+        assign cptra_ss_i3c_sda_io = i3c_ctrl_sda_o ? 1'bz : 1'b0;
+        assign i3c_scl = cptra_ss_i3c_scl_io !== 1'b0;
+        assign i3c_sda = cptra_ss_i3c_sda_io !== 1'b0;
+    `endif
+
+    css_i3c_ctrl css_i3c_ctrl (
+        .clk            (core_clk),
+        .rst_l          (rst_l),
+        .mailbox_write  (mailbox_write),
+        .mailbox_data   (mailbox_data[31:0]),
+        .scl_i          (i3c_scl),
+        .sda_i          (i3c_sda),
+        .scl_o          (i3c_ctrl_scl_o),
+        .sda_o          (i3c_ctrl_sda_o),
+        .done           ()
+    );
+`endif
 
     //instantiate caliptra ss top module
     logic [124:0] cptra_ss_cptra_generic_fw_exec_ctrl_o;
@@ -1858,10 +2292,17 @@ module caliptra_ss_top_tb
     
     // I3C Interface
     `ifdef DIGITAL_IO_I3C
+      `ifdef AVERY_I3C
         .cptra_ss_i3c_scl_i(master0_intf.scl_and),
         .cptra_ss_i3c_sda_i(master0_intf.sda_and),
         .cptra_ss_i3c_scl_o(master0_intf.scl_and),
         .cptra_ss_i3c_sda_o(master0_intf.sda_and),
+      `else
+        .cptra_ss_i3c_scl_i(i3c_scl),
+        .cptra_ss_i3c_sda_i(i3c_sda),
+        .cptra_ss_i3c_scl_o,
+        .cptra_ss_i3c_sda_o,
+      `endif
         .cptra_ss_sel_od_pp_o,
     `else
         .cptra_ss_i3c_scl_io,
@@ -1881,21 +2322,93 @@ module caliptra_ss_top_tb
     
 
 
-task preload_mcu_sram;
-    bit[MCU_SRAM_ECC_WIDTH-1:0] ecc;
-    bit[MCU_SRAM_DATA_WIDTH-1:0] data;
-    bit[31:0] addr;
+// Backdoor load of the MCU ROM, MCU SRAM and DCCM preloaders from the firmware
+// ELF, same address windows as the objcopy hex files
+task load_mcu_elf;
+    int n;
 
+    n = elf_loader_load(mcu_elf_ctx, 32'h8000_0000, imem.ram);
+    $display("MCU ROM loaded from %s: %0d bytes", mcu_elf, n);
+    n = elf_loader_load(mcu_elf_ctx, 32'h2120_0000, lmem_dummy_preloader.ram);
+    $display("MCU SRAM loaded from %s: %0d bytes", mcu_elf, n);
+    n = elf_loader_load(mcu_elf_ctx, `css_mcu0_RV_DCCM_SADR, css_mcu0_dummy_dccm_preloader.ram);
+    $display("MCU DCCM loaded from %s: %0d bytes", mcu_elf, n);
+    elf_loader_close(mcu_elf_ctx);
+    mcu_elf_ctx = null;
+endtask
+
+// Console log (mcu_console.log) and command event log (mcu_events.jsonl)
+//   +CONSOLE_CYCLE_PREFIX - prefix console lines with cycleCnt
+//   +CONSOLE_FLUSH        - flush mcu_console.log after every line, e.g. for tail -f
+//   +NO_EVENT_LOG         - no mcu_events.jsonl
+function chandle open_console;
+    chandle ctx;
+    int     flags;
+
+    flags = ($test$plusargs("CONSOLE_CYCLE_PREFIX") ? CONSOLE_MON_PREFIX : 0) |
+            ($test$plusargs("CONSOLE_FLUSH")        ? CONSOLE_MON_FLUSH  : 0);
+    ctx = console_mon_open("mcu_console.log", $test$plusargs("NO_EVENT_LOG") ? "" : "mcu_events.jsonl", flags);
+    if (ctx == null) begin
+        $error("Unable to open the MCU console log");
+        $finish;
+    end
+    return ctx;
+endfunction
+
+// Runs in each test forked from the post-boot checkpoint, with the test
+// directory as working directory. Log files are reopened there, and the test
+// firmware (+MCU_ELF, relative to the test directory) replaces the checkpoint
+// image while the MCU is held in the reset requested by the checkpoint firmware.
+// The exec region lock override that reset waits for is set by the checkpoint
+// firmware and released by the test (css_cptra_boot()).
+task checkpoint_resume;
+    console_mon_close(console);
+    console = open_console();
+    if (bench_fd) begin
+        $fclose(bench_fd);
+        bench_fd = $fopen("mcu_bench.csv","w");
+    end
+    text_trace_en = $test$plusargs("TEXT_TRACE");
+    bin_trace_en  = !$test$plusargs("NO_BIN_TRACE");
+    if (text_trace_en) begin
+        tp = $fopen("trace_port.csv","w");
+        el = $fopen("mcu_exec.log","w");
+        $fwrite (el, "//   Cycle : #inst    0    pc    opcode    reg=value    csr=value     ; mnemonic\n");
+    end
+
+    fork
+        begin
+            wait (caliptra_ss_dut.mci_top_i.mcu_rst_b === 1'b0);
+            mcu_elf_ctx = elf_loader_open(mcu_elf);
+            if (mcu_elf_ctx == null) begin
+                $error("Unable to load MCU firmware ELF %s", mcu_elf);
+                $finish;
+            end
+            load_mcu_elf();
+            preload_css_mcu0_dccm(1);
+            preload_mcu_sram(1);
+            wait (caliptra_ss_dut.mci_top_i.mcu_rst_b === 1'b1);
+            $display("[%0d] MCU restarted from checkpoint with %s", cycleCnt, mcu_elf);
+        end
+    join_none
+endtask
+
+// ECC codes are computed in ecc_preload.c; zero words are skipped, so the
+// memory must start out cleared (explicitly here, by default in Verilator)
+task preload_mcu_sram(input bit clear = 0);
+    int n;
+
+    $display("MCU SRAM pre-load from %h to %h", 0, MCU_SRAM_DEPTH-1);
+
+    `ifdef TB_SPARSE_MEM
+    n = ecc_preload_sparse(lmem_dummy_preloader.ram, 0, 1, clear, lmem.handle(), MCU_SRAM_DEPTH);
+    `else
     `ifndef VERILATOR
     lmem.ram = '{default: '0};
     `endif
-    $display("MCU SRAM pre-load from %h to %h", 0, MCU_SRAM_DEPTH-1);
-
-    for(addr= 0; addr < MCU_SRAM_DEPTH; addr++) begin
-        data = {lmem_dummy_preloader.ram[addr][3],lmem_dummy_preloader.ram[addr][2],lmem_dummy_preloader.ram[addr][1],lmem_dummy_preloader.ram[addr][0]};
-        ecc = |data  ? riscv_ecc32(data) : 0; 
-        lmem.ram[addr] = {ecc,data};
-    end
+    n = ecc_preload_bit(lmem_dummy_preloader.ram, 0, 1, clear, lmem.ram);
+    `endif
+    $display("MCU SRAM pre-load completed, %0d words written", n);
 
 endtask
 
@@ -1986,56 +2499,97 @@ function int get_iccm_bank(input[31:0] addr,  output int bank_idx);
     `endif
 endfunction
 
+// Gather the 32-bit words of [lo, hi) into dump, word 0 of the dump being
+// address base. Covers the DCCM banks, the MCU SRAM and the MCU ROM model;
+// other addresses read as 0.
+task automatic dump_mem_range(input chandle d, input longint base, input longint lo, input longint hi);
+    longint a0, a1;
+
+    `ifdef css_mcu0_RV_DCCM_ENABLE
+    // DCCM words are interleaved over the banks: one strided gather per bank
+    a0 = lo > `css_mcu0_RV_DCCM_SADR ? lo : `css_mcu0_RV_DCCM_SADR;
+    a1 = hi < longint'(`css_mcu0_RV_DCCM_EADR) + 1 ? hi : longint'(`css_mcu0_RV_DCCM_EADR) + 1;
+    for (longint a = a0; a < a0 + 4 * pt.DCCM_NUM_BANKS && a < a1; a += 4) begin
+        int bank, indx, n;
+        bank = get_dccm_bank(a[31:0], indx);
+        n = (a1 - a + 4 * pt.DCCM_NUM_BANKS - 1) / (4 * pt.DCCM_NUM_BANKS);
+        case (bank)
+        0: mem_dump_reg(d, `MCU_DRAM(0), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        1: mem_dump_reg(d, `MCU_DRAM(1), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        `ifdef css_mcu0_RV_DCCM_NUM_BANKS_4
+        2: mem_dump_reg(d, `MCU_DRAM(2), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        3: mem_dump_reg(d, `MCU_DRAM(3), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        `endif
+        `ifdef css_mcu0_RV_DCCM_NUM_BANKS_8
+        2: mem_dump_reg(d, `MCU_DRAM(2), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        3: mem_dump_reg(d, `MCU_DRAM(3), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        4: mem_dump_reg(d, `MCU_DRAM(4), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        5: mem_dump_reg(d, `MCU_DRAM(5), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        6: mem_dump_reg(d, `MCU_DRAM(6), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        7: mem_dump_reg(d, `MCU_DRAM(7), indx, (a - base) / 4, pt.DCCM_NUM_BANKS, n);
+        `endif
+        endcase
+    end
+    `endif
+
+    // MCU SRAM, {ecc, data} words
+    a0 = lo > MCU_SRAM_BASE ? lo : MCU_SRAM_BASE;
+    a1 = hi < MCU_SRAM_BASE + MCU_SRAM_SIZE_KB * 1024 ? hi : MCU_SRAM_BASE + MCU_SRAM_SIZE_KB * 1024;
+    if (a0 < a1) begin
+        `ifdef TB_SPARSE_MEM
+        mem_dump_sparse(d, lmem.handle(), (a0 - MCU_SRAM_BASE) / 4, (a0 - base) / 4, 1, (a1 - a0 + 3) / 4);
+        `else
+        mem_dump_bit(d, lmem.ram, (a0 - MCU_SRAM_BASE) / 4, (a0 - base) / 4, 1, (a1 - a0 + 3) / 4);
+        `endif
+    end
+
+    // MCU ROM
+    a0 = lo > MCU_ROM_BASE ? lo : MCU_ROM_BASE;
+    a1 = hi < MCU_ROM_BASE + MCU_ROM_SIZE ? hi : MCU_ROM_BASE + MCU_ROM_SIZE;
+    if (a0 < a1)
+        mem_dump_bytes(d, imem.ram, a0 - MCU_ROM_BASE, (a0 - base) / 4, (a1 - a0 + 3) / 4);
+endtask
+
 task dump_signature ();
-        integer fp, i;
+        chandle d;
+        int     n;
 
         $display("Dumping memory signature (0x%08X - 0x%08X)...",
             mem_signature_begin,
             mem_signature_end
         );
 
-        fp = $fopen("veer.signature", "w");
-        for (i=mem_signature_begin; i<mem_signature_end; i=i+4) begin
-
-            // From DCCM
-    `ifdef css_mcu0_RV_DCCM_ENABLE
-            if (i >= `css_mcu0_RV_DCCM_SADR && i < `css_mcu0_RV_DCCM_EADR) begin
-                bit[38:0] data;
-                int bank, indx;
-                bank = get_dccm_bank(i, indx);
-
-                case (bank)
-                0: data = `MCU_DRAM(0)[indx];
-                1: data = `MCU_DRAM(1)[indx];
-                `ifdef css_mcu0_RV_DCCM_NUM_BANKS_4
-                2: data = `MCU_DRAM(2)[indx];
-                3: data = `MCU_DRAM(3)[indx];
-                `endif
-                `ifdef css_mcu0_RV_DCCM_NUM_BANKS_8
-                2: data = `MCU_DRAM(2)[indx];
-                3: data = `MCU_DRAM(3)[indx];
-                4: data = `MCU_DRAM(4)[indx];
-                5: data = `MCU_DRAM(5)[indx];
-                6: data = `MCU_DRAM(6)[indx];
-                7: data = `MCU_DRAM(7)[indx];
-                `endif
-                endcase
-
-                $fwrite(fp, "%08X\n", data[31:0]);
-            end else
-    `endif
-            // From RAM
-            begin
-                $fwrite(fp, "%02X%02X%02X%02X\n",
-                    lmem.ram[i+3],
-                    lmem.ram[i+2],
-                    lmem.ram[i+1],
-                    lmem.ram[i+0]
-                );
-            end
-        end
+        d = mem_dump_begin((mem_signature_end - mem_signature_begin + 3) / 4);
+        dump_mem_range(d, mem_signature_begin, mem_signature_begin, mem_signature_end);
+        n = mem_dump_finish(d, "veer.signature", 0);
+        if (n < 0) $error("Unable to write veer.signature");
+endtask
 
-        $fclose(fp);
+// Snapshot of a whole TB memory, STDOUT command 0x8C
+//   region 0: DCCM, 1: MCU SRAM, 2: MCU ROM
+// written to mem_snapshot_<region>_<n>.bin (raw little endian words) or .hex
+int mem_snapshot_count = 0;
+
+task automatic snapshot_mem(input int region, input bit binary);
+    string  name, path;
+    longint lo, hi;
+    chandle d;
+    int     n;
+
+    case (region)
+    0: begin name = "dccm";     lo = `css_mcu0_RV_DCCM_SADR; hi = longint'(`css_mcu0_RV_DCCM_EADR) + 1; end
+    1: begin name = "mcu_sram"; lo = MCU_SRAM_BASE;          hi = MCU_SRAM_BASE + MCU_SRAM_SIZE_KB * 1024; end
+    2: begin name = "mcu_rom";  lo = MCU_ROM_BASE;           hi = MCU_ROM_BASE + MCU_ROM_SIZE; end
+    default: begin
+        $display("[%0d] Unknown memory snapshot region %0d", cycleCnt, region);
+        return;
+    end
+    endcase
+    path = $sformatf("mem_snapshot_%s_%0d.%s", name, mem_snapshot_count++, binary ? "bin" : "hex");
+    d = mem_dump_begin((hi - lo) / 4);
+    dump_mem_range(d, lo, lo, hi);
+    n = mem_dump_finish(d, path, binary);
+    $display("[%0d] %s snapshot (0x%08X - 0x%08X): %0d words to %s", cycleCnt, name, lo, hi - 1, n, path);
 endtask
 
 
@@ -2097,9 +2651,9 @@ task slam_dccm_ram(input [31:0] addr, input[38:0] data);
     //$display("Writing bank %0d indx=%0d A=%h, D=%h",bank, indx, addr, data);
 endtask
 
-task static preload_css_mcu0_dccm;
-    bit[31:0] data;
-    bit[31:0] addr, saddr, eaddr;
+task static preload_css_mcu0_dccm(input bit clear = 0);
+    bit[31:0] saddr, eaddr;
+    int       n;
 
     `ifndef VERILATOR
     init_css_mcu0_dccm();
@@ -2115,15 +2669,26 @@ task static preload_css_mcu0_dccm;
     eaddr = `css_mcu0_RV_DCCM_EADR;
     $display("CSS MCU0 DCCM pre-load from %h to %h", saddr, eaddr);
 
-    for(addr=saddr; addr <= eaddr; addr+=4) begin
-        // FIXME hardcoded address indices?
-        data = {css_mcu0_dummy_dccm_preloader.ram [addr[16:3]] [{addr[2],2'h3}],
-                css_mcu0_dummy_dccm_preloader.ram [addr[16:3]] [{addr[2],2'h2}],
-                css_mcu0_dummy_dccm_preloader.ram [addr[16:3]] [{addr[2],2'h1}],
-                css_mcu0_dummy_dccm_preloader.ram [addr[16:3]] [{addr[2],2'h0}]};
-        slam_dccm_ram(addr, data == 0 ? 0 : {riscv_ecc32(data),data});
-    end
-    $display("CSS MCU0 DCCM pre-load completed");
+    // Words are interleaved across banks (see get_dccm_bank), bank b holds
+    // preloader words b, b + NUM_BANKS, ...
+    n = 0;
+    `ifdef css_mcu0_RV_DCCM_ENABLE
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 0, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(0));
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 1, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(1));
+    `ifdef css_mcu0_RV_DCCM_NUM_BANKS_4
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 2, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(2));
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 3, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(3));
+    `endif
+    `ifdef css_mcu0_RV_DCCM_NUM_BANKS_8
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 2, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(2));
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 3, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(3));
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 4, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(4));
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 5, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(5));
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 6, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(6));
+    n += ecc_preload_reg(css_mcu0_dummy_dccm_preloader.ram, 7, pt.DCCM_NUM_BANKS, clear, `MCU_DRAM(7));
+    `endif
+    `endif
+    $display("CSS MCU0 DCCM pre-load completed, %0d words written", n);
 
 endtask
 
@@ -3031,7 +3596,9 @@ end // block: PACKED_1
 
 endmodule
 
+`ifdef AVERY_I3C
 // --- Avery I3C Test Case Bench ---
 // This is the top level module for the Avery I3C test case bench.
 // it triggers i3c test cases.
 `include "ai3c_tests_bench.sv"
+`endif
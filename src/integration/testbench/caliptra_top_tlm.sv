@@ -0,0 +1,309 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Transaction level Caliptra core stand-in
+//
+// Drop-in for caliptra_top, selected with +define+CALIPTRA_CORE_TLM (make
+// CPTRA_TLM=1), for MCU firmware and SoC flow tests that only need the core
+// to boot and answer mailbox commands. Skipping the core RTL and its ROM
+// removes most of the simulation time before ready_for_mb_processing.
+//
+// The AXI sub accepts one read and one write burst at a time and passes each
+// beat to the C++ model (cptra_tlm.cpp), which implements the boot FSM, flow
+// status, the mailbox protocol and plain storage for the other soc_ifc and
+// SHA accelerator registers. The DMA manager stays idle, the SRAM, JTAG and
+// error outputs are tied off. SS_GENERIC_FW_EXEC_CTRL is driven from what the
+// SoC wrote to the registers, as there is no runtime firmware to set it.
+// Plusargs:
+//   +CPTRA_TLM_ROM_CYCLES=<n>   boot FSM done to ready_for_mb_processing
+//                               (default 1000)
+//   +CPTRA_TLM_MBOX_CYCLES=<n>  mailbox EXECUTE to response (default 100)
+//   +CPTRA_TLM_LOG=<file>       mailbox command log (default cptra_tlm.log)
+
+module caliptra_top_tlm
+    import axi_pkg::*;
+    import cptra_tlm_pkg::*;
+    import soc_ifc_pkg::*;
+(
+    input bit                          clk,
+
+    input logic                        cptra_pwrgood,
+    input logic                        cptra_rst_b,
+
+    input logic [255:0]                              cptra_obf_key,
+    input logic                                      cptra_obf_uds_seed_vld,
+    input logic [`CLP_OBF_UDS_DWORDS-1:0][31:0]      cptra_obf_uds_seed,
+    input logic                                      cptra_obf_field_entropy_vld,
+    input logic [`CLP_OBF_FE_DWORDS-1:0][31:0]       cptra_obf_field_entropy,
+    input logic [`CLP_CSR_HMAC_KEY_DWORDS-1:0][31:0] cptra_csr_hmac_key,
+
+    input logic                        jtag_tck,
+    input logic                        jtag_tdi,
+    input logic                        jtag_tms,
+    input logic                        jtag_trst_n,
+    output logic                       jtag_tdo,
+    output logic                       jtag_tdoEn,
+
+    //SoC AXI Interface
+    axi_if.w_sub s_axi_w_if,
+    axi_if.r_sub s_axi_r_if,
+
+    //AXI DMA Interface
+    axi_if.w_mgr m_axi_w_if,
+    axi_if.r_mgr m_axi_r_if,
+
+    el2_mem_if.veer_sram_src           el2_mem_export,
+    mldsa_mem_if.req                   mldsa_memory_export,
+
+    output logic                       ready_for_fuses,
+    output logic                       ready_for_mb_processing,
+    output logic                       ready_for_runtime,
+
+    output logic                       mbox_sram_cs,
+    output logic                       mbox_sram_we,
+    output logic [CPTRA_MBOX_ADDR_W-1:0] mbox_sram_addr,
+    output logic [CPTRA_MBOX_DATA_AND_ECC_W-1:0] mbox_sram_wdata,
+    input  logic [CPTRA_MBOX_DATA_AND_ECC_W-1:0] mbox_sram_rdata,
+
+    output logic imem_cs,
+    output logic [`CALIPTRA_IMEM_ADDR_WIDTH-1:0] imem_addr,
+    input  logic [`CALIPTRA_IMEM_DATA_WIDTH-1:0] imem_rdata,
+
+    output logic                       mailbox_data_avail,
+    output logic                       mailbox_flow_done,
+    input logic                        BootFSM_BrkPoint,
+
+    input logic                        recovery_data_avail,
+    input logic                        recovery_image_activated,
+
+    //SoC Interrupts
+    output logic                       cptra_error_fatal,
+    output logic                       cptra_error_non_fatal,
+
+    output logic                       etrng_req,
+    input  logic [3:0]                 itrng_data,
+    input  logic                       itrng_valid,
+
+    // Subsystem mode straps
+    input logic [63:0]                 strap_ss_caliptra_base_addr,
+    input logic [63:0]                 strap_ss_mci_base_addr,
+    input logic [63:0]                 strap_ss_recovery_ifc_base_addr,
+    input logic [63:0]                 strap_ss_otp_fc_base_addr,
+    input logic [63:0]                 strap_ss_uds_seed_base_addr,
+    input logic [31:0]                 strap_ss_prod_debug_unlock_auth_pk_hash_reg_bank_offset,
+    input logic [31:0]                 strap_ss_num_of_prod_debug_unlock_auth_pk_hashes,
+    input logic [31:0]                 strap_ss_strap_generic_0,
+    input logic [31:0]                 strap_ss_strap_generic_1,
+    input logic [31:0]                 strap_ss_strap_generic_2,
+    input logic [31:0]                 strap_ss_strap_generic_3,
+    input logic                        ss_debug_intent,
+
+    // Subsystem mode debug outputs
+    output logic                       ss_dbg_manuf_enable,
+    output logic [63:0]                ss_soc_dbg_unlock_level,
+
+    // Subsystem mode firmware execution control
+    output logic [127:0]               ss_generic_fw_exec_ctrl,
+
+    input  logic [63:0]                generic_input_wires,
+    output logic [63:0]                generic_output_wires,
+
+    input security_state_t             security_state,
+    input logic                        scan_mode
+);
+
+    localparam IW = $bits(s_axi_w_if.awid);
+    localparam UW = $bits(s_axi_w_if.awuser);
+
+    chandle      ctx;
+    int unsigned rom_cycles, mbox_cycles;
+    string       log_path;
+    logic        rst_b;
+    logic        booted;
+    int          flags;
+
+    // Write burst
+    logic          aw_busy;
+    logic [31:0]   aw_addr;
+    logic [IW-1:0] aw_id;
+    logic [UW-1:0] aw_user;
+    logic [1:0]    aw_burst;
+    logic [2:0]    aw_size;
+    logic [1:0]    b_resp;
+    logic          b_valid;
+
+    // Read burst
+    logic          ar_busy;
+    logic [31:0]   ar_addr;
+    logic [IW-1:0] ar_id;
+    logic [UW-1:0] ar_user;
+    logic [1:0]    ar_burst;
+    logic [2:0]    ar_size;
+    logic [7:0]    ar_len, ar_beat;
+    logic [31:0]   r_data;
+    logic [1:0]    r_resp;
+    logic          r_valid;
+
+    function automatic logic [31:0] next_addr(logic [31:0] addr, logic [1:0] burst, logic [2:0] size);
+        return burst == AXI_BURST_FIXED ? addr : addr + (32'h1 << size);
+    endfunction
+
+    initial begin
+        if (!$value$plusargs("CPTRA_TLM_ROM_CYCLES=%d", rom_cycles))   rom_cycles  = 1000;
+        if (!$value$plusargs("CPTRA_TLM_MBOX_CYCLES=%d", mbox_cycles)) mbox_cycles = 100;
+        if (!$value$plusargs("CPTRA_TLM_LOG=%s", log_path))            log_path    = "cptra_tlm.log";
+        ctx = cptra_tlm_open(rom_cycles, mbox_cycles, log_path);
+        if (ctx == null) $fatal(1, "caliptra_top_tlm: cannot create the Caliptra core model");
+        $display("Caliptra core replaced by the transaction level model, ROM %0d cycles, mailbox %0d cycles",
+                 rom_cycles, mbox_cycles);
+    end
+
+    assign rst_b = cptra_rst_b && cptra_pwrgood;
+
+    always @(posedge clk or negedge rst_b) begin
+        if (!rst_b) begin
+            booted   <= 1'b0;
+            flags    <= 0;
+            aw_busy  <= 1'b0;
+            b_valid  <= 1'b0;
+            b_resp   <= AXI_RESP_OKAY;
+            ar_busy  <= 1'b0;
+            r_valid  <= 1'b0;
+            r_resp   <= AXI_RESP_OKAY;
+            r_data   <= '0;
+            ar_len   <= '0;
+            ar_beat  <= '0;
+            ss_generic_fw_exec_ctrl <= '0;
+        end
+        else begin
+            // First clock out of reset starts the boot FSM
+            if (!booted) begin
+                booted <= 1'b1;
+                cptra_tlm_reset(ctx, int'(BootFSM_BrkPoint));
+            end
+            flags <= cptra_tlm_tick(ctx);
+            for (int i = 0; i < 4; i++)
+                ss_generic_fw_exec_ctrl[i*32 +: 32] <= cptra_tlm_fw_exec_ctrl(ctx, i);
+
+            // Write: AW, then one model write per W beat, B after WLAST
+            if (s_axi_w_if.awvalid && !aw_busy) begin
+                aw_busy  <= 1'b1;
+                aw_addr  <= s_axi_w_if.awaddr[31:0];
+                aw_id    <= s_axi_w_if.awid;
+                aw_user  <= s_axi_w_if.awuser;
+                aw_burst <= s_axi_w_if.awburst;
+                aw_size  <= s_axi_w_if.awsize;
+                b_resp   <= AXI_RESP_OKAY;
+            end
+            if (s_axi_w_if.wvalid && aw_busy && !b_valid) begin
+                if (cptra_tlm_write(ctx, aw_addr, s_axi_w_if.wdata[31:0], 32'(s_axi_w_if.wstrb[3:0]), 32'(aw_user)) != 0)
+                    b_resp <= AXI_RESP_SLVERR;
+                aw_addr <= next_addr(aw_addr, aw_burst, aw_size);
+                if (s_axi_w_if.wlast) b_valid <= 1'b1;
+            end
+            if (b_valid && s_axi_w_if.bready) begin
+                b_valid <= 1'b0;
+                aw_busy <= 1'b0;
+            end
+
+            // Read: AR, then one model read per beat, each held until RREADY
+            if (s_axi_r_if.arvalid && !ar_busy) begin
+                ar_busy  <= 1'b1;
+                ar_addr  <= s_axi_r_if.araddr[31:0];
+                ar_id    <= s_axi_r_if.arid;
+                ar_user  <= s_axi_r_if.aruser;
+                ar_burst <= s_axi_r_if.arburst;
+                ar_size  <= s_axi_r_if.arsize;
+                ar_len   <= s_axi_r_if.arlen;
+                ar_beat  <= '0;
+            end
+            if (ar_busy && !r_valid) begin
+                automatic int unsigned data;
+                r_resp  <= cptra_tlm_read(ctx, ar_addr, 32'(ar_user), data) != 0 ? AXI_RESP_SLVERR : AXI_RESP_OKAY;
+                r_data  <= data;
+                r_valid <= 1'b1;
+            end
+            if (r_valid && s_axi_r_if.rready) begin
+                r_valid <= 1'b0;
+                ar_addr <= next_addr(ar_addr, ar_burst, ar_size);
+                ar_beat <= ar_beat + 1;
+                if (ar_beat == ar_len) ar_busy <= 1'b0;
+            end
+        end
+    end
+
+    final begin
+        cptra_tlm_close(ctx);
+    end
+
+    assign s_axi_w_if.awready = !aw_busy;
+    assign s_axi_w_if.wready  = aw_busy && !b_valid;
+    assign s_axi_w_if.bvalid  = b_valid;
+    assign s_axi_w_if.bresp   = b_resp;
+    assign s_axi_w_if.bid     = aw_id;
+
+    assign s_axi_r_if.arready = !ar_busy;
+    assign s_axi_r_if.rvalid  = r_valid;
+    assign s_axi_r_if.rdata   = r_data;
+    assign s_axi_r_if.rresp   = r_resp;
+    assign s_axi_r_if.rid     = ar_id;
+    assign s_axi_r_if.rlast   = ar_beat == ar_len;
+
+    assign ready_for_fuses         = |(flags & CPTRA_TLM_READY_FOR_FUSES);
+    assign ready_for_mb_processing = |(flags & CPTRA_TLM_READY_FOR_MB_PROCESSING);
+    assign ready_for_runtime       = |(flags & CPTRA_TLM_READY_FOR_RUNTIME);
+    assign mailbox_data_avail      = |(flags & CPTRA_TLM_MAILBOX_DATA_AVAIL);
+    assign mailbox_flow_done       = 1'b0;
+
+    // DMA manager idle
+    assign m_axi_w_if.awvalid = 1'b0;
+    assign m_axi_w_if.awaddr  = '0;
+    assign m_axi_w_if.awid    = '0;
+    assign m_axi_w_if.awlen   = '0;
+    assign m_axi_w_if.awsize  = '0;
+    assign m_axi_w_if.awburst = '0;
+    assign m_axi_w_if.awlock  = '0;
+    assign m_axi_w_if.awuser  = '0;
+    assign m_axi_w_if.wvalid  = 1'b0;
+    assign m_axi_w_if.wdata   = '0;
+    assign m_axi_w_if.wstrb   = '0;
+    assign m_axi_w_if.wlast   = 1'b0;
+    assign m_axi_w_if.bready  = 1'b1;
+    assign m_axi_r_if.arvalid = 1'b0;
+    assign m_axi_r_if.araddr  = '0;
+    assign m_axi_r_if.arid    = '0;
+    assign m_axi_r_if.arlen   = '0;
+    assign m_axi_r_if.arsize  = '0;
+    assign m_axi_r_if.arburst = '0;
+    assign m_axi_r_if.arlock  = '0;
+    assign m_axi_r_if.aruser  = '0;
+    assign m_axi_r_if.rready  = 1'b1;
+
+    assign jtag_tdo                = 1'b0;
+    assign jtag_tdoEn              = 1'b0;
+    assign mbox_sram_cs            = 1'b0;
+    assign mbox_sram_we            = 1'b0;
+    assign mbox_sram_addr          = '0;
+    assign mbox_sram_wdata         = '0;
+    assign imem_cs                 = 1'b0;
+    assign imem_addr               = '0;
+    assign cptra_error_fatal       = 1'b0;
+    assign cptra_error_non_fatal   = 1'b0;
+    assign etrng_req               = 1'b0;
+    assign ss_dbg_manuf_enable     = 1'b0;
+    assign ss_soc_dbg_unlock_level = '0;
+    assign generic_output_wires    = '0;
+
+endmodule
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// AXI sub tie-off for blocks left out of a DUT profile
+//
+// Takes the place of the AXI sub of a stubbed block (CSS_STUB_I3C,
+// CSS_STUB_FC_LCC in caliptra_ss_top). Every request completes with the
+// RESP response and no data, one read and one write burst at a time, so a
+// stray access fails on the bus instead of hanging the test. The first
+// accesses are reported with NAME. Read data is tied off by the caller.
+
+module css_axi_stub #(
+    parameter string      NAME = "stub",
+    parameter int         IW   = 8,
+    parameter logic [1:0] RESP = 2'b11 // DECERR
+) (
+    input  logic          clk,
+    input  logic          rst_n,
+
+    input  logic          awvalid,
+    output logic          awready,
+    input  logic [31:0]   awaddr,
+    input  logic [IW-1:0] awid,
+    input  logic          wvalid,
+    output logic          wready,
+    input  logic          wlast,
+    output logic          bvalid,
+    input  logic          bready,
+    output logic [1:0]    bresp,
+    output logic [IW-1:0] bid,
+
+    input  logic          arvalid,
+    output logic          arready,
+    input  logic [31:0]   araddr,
+    input  logic [IW-1:0] arid,
+    input  logic [7:0]    arlen,
+    output logic          rvalid,
+    input  logic          rready,
+    output logic [1:0]    rresp,
+    output logic [IW-1:0] rid,
+    output logic          rlast
+);
+
+    localparam int MaxReports = 8;
+
+    logic       aw_busy, ar_busy;
+    logic [7:0] ar_len, ar_beat;
+    int         reports;
+
+    function automatic void report(string dir, logic [31:0] addr);
+        if (reports < MaxReports)
+            $display("%m: %s is not in this DUT profile, %s 0x%08x answered with error", NAME, dir, addr);
+        reports++;
+    endfunction
+
+    always @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            aw_busy <= 1'b0;
+            bvalid  <= 1'b0;
+            bid     <= '0;
+            ar_busy <= 1'b0;
+            ar_len  <= '0;
+            ar_beat <= '0;
+            rid     <= '0;
+        end
+        else begin
+            if (awvalid && awready) begin
+                aw_busy <= 1'b1;
+                bid     <= awid;
+                report("write", awaddr);
+            end
+            if (wvalid && wready && wlast) bvalid <= 1'b1;
+            if (bvalid && bready) begin
+                bvalid  <= 1'b0;
+                aw_busy <= 1'b0;
+            end
+
+            if (arvalid && arready) begin
+                ar_busy <= 1'b1;
+                ar_len  <= arlen;
+                ar_beat <= '0;
+                rid     <= arid;
+                report("read", araddr);
+            end
+            if (rvalid && rready) begin
+                ar_beat <= ar_beat + 1;
+                if (rlast) ar_busy <= 1'b0;
+            end
+        end
+    end
+
+    initial reports = 0;
+
+    final begin
+        if (reports > MaxReports)
+            $display("%m: %s, %0d accesses in total", NAME, reports);
+    end
+
+    assign awready = !aw_busy;
+    assign wready  = aw_busy && !bvalid;
+    assign bresp   = RESP;
+
+    assign arready = !ar_busy;
+    assign rvalid  = ar_busy;
+    assign rresp   = RESP;
+    assign rlast   = ar_beat == ar_len;
+
+endmodule
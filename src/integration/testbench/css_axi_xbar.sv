@@ -0,0 +1,568 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// AXI4 crossbar for the subsystem TB
+//
+// License-free stand-in for aaxi4_interconnect (Avery AXI VIP), used when the
+// TB is built without AVERY_AXI_INTERCONNECT, e.g. with Verilator. It has the
+// same mintf_arr[]/sintf_arr[] ports with the same signal names, so the TB
+// connects to either one with the same hierarchical assignments, and the
+// same address map:
+//
+//   slave 0  imem            0x1000_0000 - 0x1000_FFFF
+//   slave 1  I3C             SOC_I3CCSR_BASE_ADDR + 4 KiB
+//   slave 2  MCU ROM         0x8000_0000 - 0x80FF_FFFF
+//   slave 3  Caliptra SoC IF 0x3000_0000 - 0x3FFF_FFFF, 0x0003_0000 - 0x0003_FFFF
+//   slave 4  MCI             SOC_MCI_REG_BASE_ADDR + 16 MiB
+//   slave 5  Fuse ctrl core  0x7000_0000 - 0x7000_01FF
+//   slave 6  Fuse ctrl prim  0x7000_0200 - 0x7000_03FF
+//   slave 7  LC ctrl         0x7000_0400 - 0x7000_05FF
+//
+// Other addresses go to a built-in default slave that answers DECERR.
+//
+// IDs are passed through unchanged. Responses are routed back by looking up
+// their ID in a per slave table of outstanding transactions; a request whose
+// ID is outstanding at the same slave for a different manager waits. Read
+// bursts are not interleaved towards a manager. Write data follows the AW
+// order per manager and per slave.
+//
+// Run time knobs:
+//   +AXI_XBAR_OUTSTANDING=<n>   transactions per slave and direction (default 4,
+//                               max MaxOutstanding)
+//   +AXI_XBAR_LATENCY=<n>       cycles an accepted AR/AW waits before it is
+//                               presented to its slave (default 0)
+//   +AXI_XBAR_LATENCY<s>=<n>    same, for slave <s> only (8 = default slave)
+
+interface css_axi_xbar_intf #(
+    parameter int AW = 64,
+    parameter int DW = 64,
+    parameter int IW = 8,
+    parameter int UW = 32
+) ();
+    logic            AWVALID;
+    logic [AW-1:0]   AWADDR;
+    logic [IW-1:0]   AWID;
+    logic [7:0]      AWLEN;
+    logic [2:0]      AWSIZE;
+    logic [1:0]      AWBURST;
+    logic            AWLOCK;
+    logic [UW-1:0]   AWUSER;
+    logic            AWREADY;
+
+    logic            WVALID;
+    logic [DW-1:0]   WDATA;
+    logic [DW/8-1:0] WSTRB;
+    logic            WLAST;
+    logic            WREADY;
+
+    logic            BVALID;
+    logic [1:0]      BRESP;
+    logic [IW-1:0]   BID;
+    logic            BREADY;
+
+    logic            ARVALID;
+    logic [AW-1:0]   ARADDR;
+    logic [IW-1:0]   ARID;
+    logic [7:0]      ARLEN;
+    logic [2:0]      ARSIZE;
+    logic [1:0]      ARBURST;
+    logic            ARLOCK;
+    logic [UW-1:0]   ARUSER;
+    logic            ARREADY;
+
+    logic            RVALID;
+    logic [DW-1:0]   RDATA;
+    logic [1:0]      RRESP;
+    logic [IW-1:0]   RID;
+    logic            RLAST;
+    logic            RREADY;
+endinterface
+
+`include "soc_address_map_defines.svh"
+
+module css_axi_xbar #(
+    parameter int NM = 5,
+    parameter int NS = 8,
+    parameter int AW = 64,
+    parameter int DW = 64,
+    parameter int IW = 8,
+    parameter int UW = 32,
+    parameter int MaxOutstanding = 8
+) (
+    input logic core_clk,
+    input logic rst_l
+);
+
+    css_axi_xbar_intf #(.AW(AW), .DW(DW), .IW(IW), .UW(UW)) mintf_arr[NM-1:0] ();
+    css_axi_xbar_intf #(.AW(AW), .DW(DW), .IW(IW), .UW(UW)) sintf_arr[NS-1:0] ();
+
+    localparam int DEF = NS;                    // default slave index
+    localparam int OW  = $clog2(MaxOutstanding + 1);
+
+    // Address map, regions are inclusive
+    localparam int NREG = 9;
+    localparam logic [63:0] REG_BASE [NREG] = '{
+        64'h1000_0000, 64'(`SOC_I3CCSR_BASE_ADDR), 64'h8000_0000, 64'h3000_0000, 64'h0003_0000,
+        64'(`SOC_MCI_REG_BASE_ADDR), 64'h7000_0000, 64'h7000_0200, 64'h7000_0400};
+    localparam logic [63:0] REG_LIMIT [NREG] = '{
+        64'h1000_FFFF, 64'(`SOC_I3CCSR_BASE_ADDR) + 64'h0FFF, 64'h80FF_FFFF, 64'h3FFF_FFFF, 64'h0003_FFFF,
+        64'(`SOC_MCI_REG_BASE_ADDR) + 64'h00FF_FFFF, 64'h7000_01FF, 64'h7000_03FF, 64'h7000_05FF};
+    localparam int REG_SLAVE [NREG] = '{0, 1, 2, 3, 3, 4, 5, 6, 7};
+
+    typedef struct packed {
+        logic [AW-1:0] addr;
+        logic [IW-1:0] id;
+        logic [7:0]    len;
+        logic [2:0]    size;
+        logic [1:0]    burst;
+        logic          lock;
+        logic [UW-1:0] user;
+    } ax_t;
+
+    function automatic int decode(logic [AW-1:0] a);
+        for (int r = 0; r < NREG; r++)
+            if (64'(a) >= REG_BASE[r] && 64'(a) <= REG_LIMIT[r]) return REG_SLAVE[r];
+        return DEF;
+    endfunction
+
+    // Round robin: first requester after the last granted one
+    function automatic int rr_pick(logic [31:0] req, int n, int last);
+        for (int k = 1; k <= n; k++) begin
+            int i = (last + k) % n;
+            if (req[i]) return i;
+        end
+        return -1;
+    endfunction
+
+    // Run time configuration
+    int unsigned outstanding;
+    int unsigned latency [NS+1];
+
+    initial begin
+        int unsigned v;
+        if (!$value$plusargs("AXI_XBAR_OUTSTANDING=%d", outstanding)) outstanding = 4;
+        if (outstanding < 1) outstanding = 1;
+        if (outstanding > MaxOutstanding) outstanding = MaxOutstanding;
+        if (!$value$plusargs("AXI_XBAR_LATENCY=%d", v)) v = 0;
+        for (int s = 0; s <= NS; s++) begin
+            latency[s] = v;
+            void'($value$plusargs($sformatf("AXI_XBAR_LATENCY%0d=%%d", s), latency[s]));
+        end
+        $display("AXI xbar: %0d managers, %0d subordinates, %0d outstanding, latency %0d",
+                 NM, NS, outstanding, v);
+    end
+
+    //=========================================================================
+    // Port flattening
+    //=========================================================================
+
+    ax_t               m_ar [NM], m_aw [NM];
+    logic [NM-1:0]     m_arvalid, m_arready, m_awvalid, m_awready;
+    logic [NM-1:0]     m_wvalid, m_wready, m_wlast, m_bvalid, m_bready, m_rvalid, m_rready, m_rlast;
+    logic [DW-1:0]     m_wdata [NM], m_rdata [NM];
+    logic [DW/8-1:0]   m_wstrb [NM];
+    logic [1:0]        m_bresp [NM], m_rresp [NM];
+    logic [IW-1:0]     m_bid [NM], m_rid [NM];
+
+    // Subordinate side, index DEF is the default slave
+    ax_t               s_ar [NS+1], s_aw [NS+1];
+    logic [NS:0]       s_arvalid, s_arready, s_awvalid, s_awready;
+    logic [NS:0]       s_wvalid, s_wready, s_wlast, s_bvalid, s_bready, s_rvalid, s_rready, s_rlast;
+    logic [DW-1:0]     s_wdata [NS+1], s_rdata [NS+1];
+    logic [DW/8-1:0]   s_wstrb [NS+1];
+    logic [1:0]        s_bresp [NS+1], s_rresp [NS+1];
+    logic [IW-1:0]     s_bid [NS+1], s_rid [NS+1];
+
+    genvar g;
+    generate
+        for (g = 0; g < NM; g++) begin : m_port
+            assign m_aw[g]      = '{mintf_arr[g].AWADDR, mintf_arr[g].AWID, mintf_arr[g].AWLEN, mintf_arr[g].AWSIZE,
+                                    mintf_arr[g].AWBURST, mintf_arr[g].AWLOCK, mintf_arr[g].AWUSER};
+            assign m_ar[g]      = '{mintf_arr[g].ARADDR, mintf_arr[g].ARID, mintf_arr[g].ARLEN, mintf_arr[g].ARSIZE,
+                                    mintf_arr[g].ARBURST, mintf_arr[g].ARLOCK, mintf_arr[g].ARUSER};
+            assign m_awvalid[g] = mintf_arr[g].AWVALID;
+            assign m_arvalid[g] = mintf_arr[g].ARVALID;
+            assign m_wvalid[g]  = mintf_arr[g].WVALID;
+            assign m_wdata[g]   = mintf_arr[g].WDATA;
+            assign m_wstrb[g]   = mintf_arr[g].WSTRB;
+            assign m_wlast[g]   = mintf_arr[g].WLAST;
+            assign m_bready[g]  = mintf_arr[g].BREADY;
+            assign m_rready[g]  = mintf_arr[g].RREADY;
+
+            assign mintf_arr[g].AWREADY = m_awready[g];
+            assign mintf_arr[g].ARREADY = m_arready[g];
+            assign mintf_arr[g].WREADY  = m_wready[g];
+            assign mintf_arr[g].BVALID  = m_bvalid[g];
+            assign mintf_arr[g].BRESP   = m_bresp[g];
+            assign mintf_arr[g].BID     = m_bid[g];
+            assign mintf_arr[g].RVALID  = m_rvalid[g];
+            assign mintf_arr[g].RDATA   = m_rdata[g];
+            assign mintf_arr[g].RRESP   = m_rresp[g];
+            assign mintf_arr[g].RID     = m_rid[g];
+            assign mintf_arr[g].RLAST   = m_rlast[g];
+        end
+
+        for (g = 0; g < NS; g++) begin : s_port
+            assign sintf_arr[g].AWVALID = s_awvalid[g];
+            assign sintf_arr[g].AWADDR  = s_aw[g].addr;
+            assign sintf_arr[g].AWID    = s_aw[g].id;
+            assign sintf_arr[g].AWLEN   = s_aw[g].len;
+            assign sintf_arr[g].AWSIZE  = s_aw[g].size;
+            assign sintf_arr[g].AWBURST = s_aw[g].burst;
+            assign sintf_arr[g].AWLOCK  = s_aw[g].lock;
+            assign sintf_arr[g].AWUSER  = s_aw[g].user;
+            assign sintf_arr[g].ARVALID = s_arvalid[g];
+            assign sintf_arr[g].ARADDR  = s_ar[g].addr;
+            assign sintf_arr[g].ARID    = s_ar[g].id;
+            assign sintf_arr[g].ARLEN   = s_ar[g].len;
+            assign sintf_arr[g].ARSIZE  = s_ar[g].size;
+            assign sintf_arr[g].ARBURST = s_ar[g].burst;
+            assign sintf_arr[g].ARLOCK  = s_ar[g].lock;
+            assign sintf_arr[g].ARUSER  = s_ar[g].user;
+            assign sintf_arr[g].WVALID  = s_wvalid[g];
+            assign sintf_arr[g].WDATA   = s_wdata[g];
+            assign sintf_arr[g].WSTRB   = s_wstrb[g];
+            assign sintf_arr[g].WLAST   = s_wlast[g];
+            assign sintf_arr[g].BREADY  = s_bready[g];
+            assign sintf_arr[g].RREADY  = s_rready[g];
+
+            assign s_awready[g] = sintf_arr[g].AWREADY;
+            assign s_arready[g] = sintf_arr[g].ARREADY;
+            assign s_wready[g]  = sintf_arr[g].WREADY;
+            assign s_bvalid[g]  = sintf_arr[g].BVALID;
+            assign s_bresp[g]   = sintf_arr[g].BRESP;
+            assign s_bid[g]     = sintf_arr[g].BID;
+            assign s_rvalid[g]  = sintf_arr[g].RVALID;
+            assign s_rdata[g]   = sintf_arr[g].RDATA;
+            assign s_rresp[g]   = sintf_arr[g].RRESP;
+            assign s_rid[g]     = sintf_arr[g].RID;
+            assign s_rlast[g]   = sintf_arr[g].RLAST;
+        end
+    endgenerate
+
+    //=========================================================================
+    // Outstanding transaction tables, per subordinate and direction
+    //=========================================================================
+
+    logic          rd_v [NS+1][MaxOutstanding], wr_v [NS+1][MaxOutstanding];
+    int            rd_m [NS+1][MaxOutstanding], wr_m [NS+1][MaxOutstanding];
+    logic [IW-1:0] rd_id[NS+1][MaxOutstanding], wr_id[NS+1][MaxOutstanding];
+    logic [OW-1:0] rd_cnt[NS+1], wr_cnt[NS+1];
+
+    // Manager of an outstanding ID, -1 if none
+    function automatic int rd_owner(int s, logic [IW-1:0] id);
+        for (int k = 0; k < MaxOutstanding; k++) if (rd_v[s][k] && rd_id[s][k] == id) return rd_m[s][k];
+        return -1;
+    endfunction
+
+    function automatic int wr_owner(int s, logic [IW-1:0] id);
+        for (int k = 0; k < MaxOutstanding; k++) if (wr_v[s][k] && wr_id[s][k] == id) return wr_m[s][k];
+        return -1;
+    endfunction
+
+    //=========================================================================
+    // Address channels: decode, arbitration and the per subordinate slot
+    //=========================================================================
+
+    int            ar_dst [NM], aw_dst [NM];
+    int            ar_gnt [NS+1], aw_gnt [NS+1];
+    int            ar_last [NS+1], aw_last [NS+1];
+    logic [NS:0]   ar_slot_v, aw_slot_v;
+    int unsigned   ar_wait [NS+1], aw_wait [NS+1];
+
+    // Write data routing: AW order per manager and per subordinate
+    int            wq_m [NM][MaxOutstanding];
+    int            wq_m_rd [NM], wq_m_cnt [NM];
+    int            wq_s [NS+1][MaxOutstanding];
+    int            wq_s_rd [NS+1], wq_s_cnt [NS+1];
+
+    always_comb begin
+        for (int m = 0; m < NM; m++) begin
+            ar_dst[m] = decode(m_ar[m].addr);
+            aw_dst[m] = decode(m_aw[m].addr);
+        end
+        m_arready = '0;
+        m_awready = '0;
+        for (int s = 0; s <= NS; s++) begin
+            logic [31:0] req;
+            int          own;
+
+            // Reads
+            req = '0;
+            for (int m = 0; m < NM; m++) begin
+                own = rd_owner(s, m_ar[m].id);
+                req[m] = m_arvalid[m] && ar_dst[m] == s && (own < 0 || own == m);
+            end
+            ar_gnt[s] = (!ar_slot_v[s] && rd_cnt[s] < outstanding) ? rr_pick(req, NM, ar_last[s]) : -1;
+            if (ar_gnt[s] >= 0) m_arready[ar_gnt[s]] = 1'b1;
+
+            // Writes, the manager's W queue must have room too
+            req = '0;
+            for (int m = 0; m < NM; m++) begin
+                own = wr_owner(s, m_aw[m].id);
+                req[m] = m_awvalid[m] && aw_dst[m] == s && (own < 0 || own == m) &&
+                         wq_m_cnt[m] < MaxOutstanding;
+            end
+            aw_gnt[s] = (!aw_slot_v[s] && wr_cnt[s] < outstanding) ? rr_pick(req, NM, aw_last[s]) : -1;
+            if (aw_gnt[s] >= 0) m_awready[aw_gnt[s]] = 1'b1;
+
+            s_arvalid[s] = ar_slot_v[s] && ar_wait[s] == 0;
+            s_awvalid[s] = aw_slot_v[s] && aw_wait[s] == 0;
+        end
+    end
+
+    //=========================================================================
+    // Write data
+    //=========================================================================
+
+    int w_src [NS+1];       // manager connected to each subordinate's W channel
+
+    always_comb begin
+        m_wready = '0;
+        for (int s = 0; s <= NS; s++) begin
+            int m;
+            w_src[s] = -1;
+            if (wq_s_cnt[s] > 0) begin
+                m = wq_s[s][wq_s_rd[s]];
+                if (wq_m_cnt[m] > 0 && wq_m[m][wq_m_rd[m]] == s) w_src[s] = m;
+            end
+            s_wvalid[s] = w_src[s] >= 0 && m_wvalid[w_src[s]];
+            s_wdata[s]  = w_src[s] >= 0 ? m_wdata[w_src[s]] : '0;
+            s_wstrb[s]  = w_src[s] >= 0 ? m_wstrb[w_src[s]] : '0;
+            s_wlast[s]  = w_src[s] >= 0 && m_wlast[w_src[s]];
+            if (w_src[s] >= 0) m_wready[w_src[s]] = s_wready[s];
+        end
+    end
+
+    //=========================================================================
+    // Read data and write response routing
+    //=========================================================================
+
+    int          r_dst [NS+1], b_dst [NS+1];
+    int          r_sel [NM], b_sel [NM];
+    int          r_last [NM], b_last [NM];
+    logic [NM-1:0] r_lock_v;
+    int          r_lock_s [NM];
+
+    always_comb begin
+        for (int s = 0; s <= NS; s++) begin
+            r_dst[s] = s_rvalid[s] ? rd_owner(s, s_rid[s]) : -1;
+            b_dst[s] = s_bvalid[s] ? wr_owner(s, s_bid[s]) : -1;
+        end
+        s_rready = '0;
+        s_bready = '0;
+        for (int m = 0; m < NM; m++) begin
+            logic [31:0] req;
+
+            req = '0;
+            for (int s = 0; s <= NS; s++) req[s] = r_dst[s] == m;
+            r_sel[m] = r_lock_v[m] ? (req[r_lock_s[m]] ? r_lock_s[m] : -1) : rr_pick(req, NS + 1, r_last[m]);
+            m_rvalid[m] = r_sel[m] >= 0;
+            m_rdata[m]  = r_sel[m] >= 0 ? s_rdata[r_sel[m]] : '0;
+            m_rresp[m]  = r_sel[m] >= 0 ? s_rresp[r_sel[m]] : '0;
+            m_rid[m]    = r_sel[m] >= 0 ? s_rid[r_sel[m]]   : '0;
+            m_rlast[m]  = r_sel[m] >= 0 && s_rlast[r_sel[m]];
+            if (r_sel[m] >= 0) s_rready[r_sel[m]] = m_rready[m];
+
+            req = '0;
+            for (int s = 0; s <= NS; s++) req[s] = b_dst[s] == m;
+            b_sel[m] = rr_pick(req, NS + 1, b_last[m]);
+            m_bvalid[m] = b_sel[m] >= 0;
+            m_bresp[m]  = b_sel[m] >= 0 ? s_bresp[b_sel[m]] : '0;
+            m_bid[m]    = b_sel[m] >= 0 ? s_bid[b_sel[m]]   : '0;
+            if (b_sel[m] >= 0) s_bready[b_sel[m]] = m_bready[m];
+        end
+    end
+
+    //=========================================================================
+    // State
+    //=========================================================================
+
+    always_ff @(posedge core_clk or negedge rst_l) begin
+        if (!rst_l) begin
+            ar_slot_v <= '0;
+            aw_slot_v <= '0;
+            r_lock_v  <= '0;
+            for (int s = 0; s <= NS; s++) begin
+                ar_last[s] <= NM - 1;
+                aw_last[s] <= NM - 1;
+                rd_cnt[s]  <= '0;
+                wr_cnt[s]  <= '0;
+                wq_s_rd[s] <= 0;
+                wq_s_cnt[s] <= 0;
+                for (int k = 0; k < MaxOutstanding; k++) begin
+                    rd_v[s][k] <= 1'b0;
+                    wr_v[s][k] <= 1'b0;
+                end
+            end
+            for (int m = 0; m < NM; m++) begin
+                r_last[m]   <= NS;
+                b_last[m]   <= NS;
+                wq_m_rd[m]  <= 0;
+                wq_m_cnt[m] <= 0;
+            end
+        end
+        else begin
+            for (int s = 0; s <= NS; s++) begin
+                int m, k;
+                logic [OW-1:0] rd_n, wr_n;
+
+                rd_n = rd_cnt[s];
+                wr_n = wr_cnt[s];
+
+                // Subordinate accepted the slot, or the slot waits out its latency
+                if (s_arvalid[s] && s_arready[s]) ar_slot_v[s] <= 1'b0;
+                else if (ar_slot_v[s] && ar_wait[s] != 0) ar_wait[s] <= ar_wait[s] - 1;
+                if (s_awvalid[s] && s_awready[s]) aw_slot_v[s] <= 1'b0;
+                else if (aw_slot_v[s] && aw_wait[s] != 0) aw_wait[s] <= aw_wait[s] - 1;
+
+                // Read grant: fill the slot, enter the table
+                m = ar_gnt[s];
+                if (m >= 0) begin
+                    s_ar[s]      <= m_ar[m];
+                    ar_slot_v[s] <= 1'b1;
+                    ar_wait[s]   <= latency[s];
+                    ar_last[s]   <= m;
+                    for (k = 0; k < MaxOutstanding && rd_v[s][k]; k++);
+                    rd_v[s][k]  <= 1'b1;
+                    rd_m[s][k]  <= m;
+                    rd_id[s][k] <= m_ar[m].id;
+                    rd_n++;
+                    if (s == DEF)
+                        $display("[%0t] AXI xbar: manager %0d read from unmapped address %h, DECERR", $time, m, m_ar[m].addr);
+                end
+
+                // Write grant: fill the slot, enter the table and the W queues
+                m = aw_gnt[s];
+                if (m >= 0) begin
+                    s_aw[s]      <= m_aw[m];
+                    aw_slot_v[s] <= 1'b1;
+                    aw_wait[s]   <= latency[s];
+                    aw_last[s]   <= m;
+                    for (k = 0; k < MaxOutstanding && wr_v[s][k]; k++);
+                    wr_v[s][k]  <= 1'b1;
+                    wr_m[s][k]  <= m;
+                    wr_id[s][k] <= m_aw[m].id;
+                    wr_n++;
+                    wq_s[s][(wq_s_rd[s] + wq_s_cnt[s]) % MaxOutstanding] <= m;
+                    if (s == DEF)
+                        $display("[%0t] AXI xbar: manager %0d write to unmapped address %h, DECERR", $time, m, m_aw[m].addr);
+                end
+
+                // Last read beat / write response retires the table entry
+                if (s_rvalid[s] && s_rready[s] && s_rlast[s]) begin
+                    for (k = 0; k < MaxOutstanding; k++)
+                        if (rd_v[s][k] && rd_id[s][k] == s_rid[s]) break;
+                    rd_v[s][k] <= 1'b0;
+                    rd_n--;
+                end
+                if (s_bvalid[s] && s_bready[s]) begin
+                    for (k = 0; k < MaxOutstanding; k++)
+                        if (wr_v[s][k] && wr_id[s][k] == s_bid[s]) break;
+                    wr_v[s][k] <= 1'b0;
+                    wr_n--;
+                end
+                rd_cnt[s] <= rd_n;
+                wr_cnt[s] <= wr_n;
+
+                // W queue of the subordinate: push on AW grant, pop on WLAST
+                wq_s_cnt[s] <= wq_s_cnt[s] + (aw_gnt[s] >= 0) - (s_wvalid[s] && s_wready[s] && s_wlast[s]);
+                if (s_wvalid[s] && s_wready[s] && s_wlast[s]) wq_s_rd[s] <= (wq_s_rd[s] + 1) % MaxOutstanding;
+            end
+
+            for (int m = 0; m < NM; m++) begin
+                logic push, pop;
+                int   s;
+
+                // W queue of the manager
+                push = 1'b0;
+                s = -1;
+                for (int t = 0; t <= NS; t++) if (aw_gnt[t] == m) begin push = 1'b1; s = t; end
+                pop = m_wvalid[m] && m_wready[m] && m_wlast[m];
+                if (push) wq_m[m][(wq_m_rd[m] + wq_m_cnt[m]) % MaxOutstanding] <= s;
+                if (pop) wq_m_rd[m] <= (wq_m_rd[m] + 1) % MaxOutstanding;
+                wq_m_cnt[m] <= wq_m_cnt[m] + push - pop;
+
+                // Read bursts stay on one subordinate until RLAST
+                if (m_rvalid[m] && m_rready[m]) begin
+                    r_lock_v[m] <= !m_rlast[m];
+                    r_lock_s[m] <= r_sel[m];
+                    r_last[m]   <= r_sel[m];
+                end
+                if (m_bvalid[m] && m_bready[m]) b_last[m] <= b_sel[m];
+            end
+        end
+    end
+
+    //=========================================================================
+    // Default subordinate: DECERR for every transaction
+    //=========================================================================
+
+    logic        dr_busy;
+    logic [8:0]  dr_beats;
+    logic [1:0]  dw_state;                  // 0 idle, 1 write data, 2 response
+    logic [IW-1:0] dr_id, dw_id;
+
+    assign s_arready[DEF] = !dr_busy;
+    assign s_rvalid[DEF]  = dr_busy;
+    assign s_rdata[DEF]   = '0;
+    assign s_rresp[DEF]   = 2'b11;
+    assign s_rid[DEF]     = dr_id;
+    assign s_rlast[DEF]   = dr_beats == 1;
+    assign s_awready[DEF] = dw_state == 0;
+    assign s_wready[DEF]  = dw_state == 1;
+    assign s_bvalid[DEF]  = dw_state == 2;
+    assign s_bresp[DEF]   = 2'b11;
+    assign s_bid[DEF]     = dw_id;
+
+    always_ff @(posedge core_clk or negedge rst_l) begin
+        if (!rst_l) begin
+            dr_busy  <= 1'b0;
+            dw_state <= 0;
+        end
+        else begin
+            if (s_arvalid[DEF] && s_arready[DEF]) begin
+                dr_busy  <= 1'b1;
+                dr_id    <= s_ar[DEF].id;
+                dr_beats <= s_ar[DEF].len + 9'd1;
+            end
+            else if (s_rvalid[DEF] && s_rready[DEF]) begin
+                dr_beats <= dr_beats - 1;
+                if (dr_beats == 1) dr_busy <= 1'b0;
+            end
+            case (dw_state)
+                0: if (s_awvalid[DEF]) begin dw_state <= 1; dw_id <= s_aw[DEF].id; end
+                1: if (s_wvalid[DEF] && s_wlast[DEF]) dw_state <= 2;
+                2: if (s_bready[DEF]) dw_state <= 0;
+                default: dw_state <= 0;
+            endcase
+        end
+    end
+
+`ifndef SYNTHESIS
+    // A response whose ID has no outstanding transaction cannot be routed
+    always @(posedge core_clk) begin
+        if (rst_l) begin
+            for (int s = 0; s < NS; s++) begin
+                if (s_rvalid[s] && r_dst[s] < 0)
+                    $error("AXI xbar: slave %0d returned read data for ID %h with no outstanding read", s, s_rid[s]);
+                if (s_bvalid[s] && b_dst[s] < 0)
+                    $error("AXI xbar: slave %0d returned a write response for ID %h with no outstanding write", s, s_bid[s]);
+            end
+        end
+    end
+`endif
+
+endmodule
@@ -0,0 +1,156 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Caliptra SS boot milestone profiler
+//
+// Timestamps the CSS boot sequence from MCI reset deassertion:
+//   - every mci_boot_seqr FSM state entry (BOOT_OTP_FC, BOOT_LCC, BOOT_BREAKPOINT,
+//     BOOT_MCU, BOOT_WAIT_CLPA_GO, BOOT_CPTRA, ...)
+//   - Caliptra ready_for_fuses and ready_for_mb_processing rising edges
+//   - CPTRA_FUSE_WR_DONE and CPTRA_BOOTFSM_GO writes seen on the Caliptra AXI sub
+//   - firmware markers, STDOUT command 0x86 with data[15:8] = marker id
+// Each milestone is recorded once (first occurrence) in cycles of clk and in
+// simulated ns, together with the time since the previous milestone. The table
+// is written to css_boot_profile.csv and printed at the end of simulation.
+// With +BOOT_PROFILE_BUDGET=<cycles> the test fails as soon as a milestone is
+// reached later than the budget, so boot-time regressions show up per run.
+
+module css_boot_profiler (
+    input logic                                  clk,
+    input logic                                  rst_l,
+    input int                                    cycleCnt,
+    input logic                                  mailbox_write,
+    input logic [31:0]                           mailbox_data,
+    input mci_pkg::mci_boot_fsm_state_e          boot_fsm,
+    input logic                                  ready_for_fuses,
+    input logic                                  ready_for_mb_processing,
+    // Caliptra AXI sub write channels
+    input logic                                  cptra_awvalid,
+    input logic                                  cptra_awready,
+    input logic [31:0]                           cptra_awaddr,
+    input logic                                  cptra_wvalid,
+    input logic                                  cptra_wready,
+    input logic [31:0]                           cptra_wdata
+);
+
+    typedef struct {
+        string       name;
+        int          cycle;
+        realtime     t;
+    } milestone_t;
+
+    milestone_t                      milestones [$];
+    bit                              seen [string];
+
+    mci_pkg::mci_boot_fsm_state_e    boot_fsm_d;
+    logic                            ready_for_fuses_d;
+    logic                            ready_for_mb_processing_d;
+    logic [31:0]                     cptra_wr_addr;
+    bit                              cptra_wr_addr_vld;
+
+    int                              start_cycle;
+    realtime                         start_t;
+    int unsigned                     budget;
+    bit                              budget_en;
+
+    function automatic void mark(string name);
+        milestone_t m;
+        if (seen.exists(name)) return;
+        seen[name] = 1'b1;
+        m.name  = name;
+        m.cycle = cycleCnt - start_cycle;
+        m.t     = $realtime - start_t;
+        milestones.push_back(m);
+        if (budget_en && m.cycle > budget) begin
+            $error("* TESTCASE FAILED: boot milestone %s reached at cycle %0d, budget %0d", name, m.cycle, budget);
+            $finish;
+        end
+    endfunction
+
+    initial begin
+        budget_en = $value$plusargs("BOOT_PROFILE_BUDGET=%d", budget);
+    end
+
+    // Time base starts when reset deasserts
+    always @(posedge rst_l) begin
+        start_cycle = cycleCnt;
+        start_t     = $realtime;
+    end
+
+    always @(posedge clk) begin
+        if (!rst_l) begin
+            boot_fsm_d                <= mci_pkg::BOOT_IDLE;
+            ready_for_fuses_d         <= 1'b0;
+            ready_for_mb_processing_d <= 1'b0;
+            cptra_wr_addr_vld         <= 1'b0;
+        end
+        else begin
+            boot_fsm_d                <= boot_fsm;
+            ready_for_fuses_d         <= ready_for_fuses;
+            ready_for_mb_processing_d <= ready_for_mb_processing;
+
+            if (boot_fsm != boot_fsm_d)
+                mark(boot_fsm.name());
+            if (ready_for_fuses && !ready_for_fuses_d)
+                mark("ready_for_fuses");
+            if (ready_for_mb_processing && !ready_for_mb_processing_d)
+                mark("ready_for_mb_processing");
+
+            // Caliptra register writes: latch AW, match on the W handshake
+            if (cptra_awvalid && cptra_awready) begin
+                cptra_wr_addr     <= cptra_awaddr;
+                cptra_wr_addr_vld <= 1'b1;
+            end
+            if (cptra_wvalid && cptra_wready) begin
+                automatic logic [31:0] addr = (cptra_awvalid && cptra_awready) ? cptra_awaddr : cptra_wr_addr;
+                if ((cptra_wr_addr_vld || (cptra_awvalid && cptra_awready)) && cptra_wdata[0]) begin
+                    if (addr == `SOC_SOC_IFC_REG_CPTRA_FUSE_WR_DONE) mark("fuse_wr_done");
+                    if (addr == `SOC_SOC_IFC_REG_CPTRA_BOOTFSM_GO)   mark("bootfsm_go");
+                end
+                if (!(cptra_awvalid && cptra_awready))
+                    cptra_wr_addr_vld <= 1'b0;
+            end
+
+            if (mailbox_write && mailbox_data[7:0] == 8'h86)
+                mark($sformatf("fw_marker_%0d", mailbox_data[15:8]));
+        end
+    end
+
+    final begin
+        integer  csv;
+        int      prev_cycle = 0;
+        realtime prev_t     = 0;
+        if (milestones.size() != 0) begin
+            csv = $fopen("css_boot_profile.csv", "w");
+            $fwrite(csv, "milestone,cycle,ns,delta_cycles,delta_ns\n");
+            $display("\n---------------- Caliptra SS boot profile ----------------");
+            $display("%-26s %10s %14s %10s %14s", "milestone", "cycle", "ns", "+cycles", "+ns");
+            foreach (milestones[i]) begin
+                $display("%-26s %10d %14.3f %10d %14.3f", milestones[i].name,
+                         milestones[i].cycle, milestones[i].t / 1ns,
+                         milestones[i].cycle - prev_cycle, (milestones[i].t - prev_t) / 1ns);
+                $fwrite(csv, "%s,%0d,%0.3f,%0d,%0.3f\n", milestones[i].name,
+                        milestones[i].cycle, milestones[i].t / 1ns,
+                        milestones[i].cycle - prev_cycle, (milestones[i].t - prev_t) / 1ns);
+                prev_cycle = milestones[i].cycle;
+                prev_t     = milestones[i].t;
+            end
+            $display("Per-milestone data in \"css_boot_profile.csv\"");
+            $display("-----------------------------------------------------------\n");
+            $fclose(csv);
+        end
+    end
+
+endmodule
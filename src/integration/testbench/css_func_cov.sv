@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Lightweight functional coverage
+//
+// Counts hits of named bins in the func_cov hit table (func_cov.c,
+// func_cov.dat in the run directory), without covergroups, so it runs on
+// every simulator at no noticeable cost. tools/func_cov_merge sums the tables
+// of a regression. Bins, "<group>.<bin>":
+//   boot_fsm.<from>-><to>       mci_boot_seqr FSM arcs; the arcs of the RTL are
+//                               declared up front, others appear when taken
+//   lc_trans.<from>-><to>       successful lc_ctrl state transitions, <from>
+//                               is the state the command was issued in
+//   lc_target.<state>           transition targets, declared up front
+// Life cycle states are named without the DecLcSt prefix, e.g. TestLocked0.
+//   fuse_prog.<partition>       fuse_ctrl DAI writes per partition, declared
+//                               up front
+//   cptra_mbox_cmd.<cmd>        Caliptra mailbox MBOX_CMD writes
+//   mcu_mbox<n>_cmd.<cmd>       MCI MCU mailbox MBOX_CMD writes
+//   tb_cmd.<cmd>                STDOUT mailbox commands (non-console bytes)
+// +NO_FUNC_COV turns it off.
+
+module css_func_cov
+    import func_cov_pkg::*;
+(
+    input logic                                  clk,
+    input logic                                  rst_l,
+    input logic                                  mailbox_write,
+    input logic [31:0]                           mailbox_data,
+    input mci_pkg::mci_boot_fsm_state_e          boot_fsm,
+    // lc_ctrl decoded state, transition target, TRANSITION_CMD write and
+    // TRANSITION_SUCCESSFUL
+    input lc_ctrl_state_pkg::dec_lc_state_e      lc_state,
+    input lc_ctrl_state_pkg::dec_lc_state_e      lc_target,
+    input logic                                  lc_trans_cmd,
+    input logic                                  lc_trans_success,
+    // fuse_ctrl DAI OTP write granted, and the partition it goes to
+    input logic                                  fuse_dai_wr,
+    input logic [7:0]                            fuse_dai_part,
+    // Caliptra AXI sub write channels
+    input logic                                  cptra_awvalid,
+    input logic                                  cptra_awready,
+    input logic [31:0]                           cptra_awaddr,
+    input logic                                  cptra_wvalid,
+    input logic                                  cptra_wready,
+    input logic [31:0]                           cptra_wdata,
+    // MCI AXI sub write channels
+    input logic                                  mci_awvalid,
+    input logic                                  mci_awready,
+    input logic [31:0]                           mci_awaddr,
+    input logic                                  mci_wvalid,
+    input logic                                  mci_wready,
+    input logic [31:0]                           mci_wdata
+);
+
+    // MCI MBOX0/MBOX1 MBOX_CMD, mci_top_defines.svh
+    localparam logic [31:0] MCI_MBOX0_CMD = `SOC_MCI_REG_BASE_ADDR + 32'h8_0008;
+    localparam logic [31:0] MCI_MBOX1_CMD = `SOC_MCI_REG_BASE_ADDR + 32'h9_0008;
+
+    chandle                              ctx;
+    mci_pkg::mci_boot_fsm_state_e        boot_fsm_d;
+    logic                                lc_trans_success_d;
+    // The decoded state reads PostTrans once the transition is done
+    lc_ctrl_state_pkg::dec_lc_state_e    lc_from;
+    logic [31:0]                         cptra_wr_addr, mci_wr_addr;
+    bit                                  cptra_wr_addr_vld, mci_wr_addr_vld;
+
+    function automatic void arc(mci_pkg::mci_boot_fsm_state_e from, mci_pkg::mci_boot_fsm_state_e to);
+        void'(func_cov_bin(ctx, $sformatf("boot_fsm.%s->%s", from.name(), to.name())));
+    endfunction
+
+    function automatic string lc_name(lc_ctrl_state_pkg::dec_lc_state_e st);
+        string name = st.name();
+        return name.substr(7, name.len() - 1); // drop "DecLcSt"
+    endfunction
+
+    initial begin
+        lc_ctrl_state_pkg::dec_lc_state_e lc_st;
+
+        if (!$test$plusargs("NO_FUNC_COV")) begin
+            ctx = func_cov_open("func_cov.dat");
+        end
+        if (ctx != null) begin
+            // Boot sequencer arcs, mci_boot_seqr.sv
+            arc(mci_pkg::BOOT_IDLE,             mci_pkg::BOOT_OTP_FC);
+            arc(mci_pkg::BOOT_OTP_FC,           mci_pkg::BOOT_LCC);
+            arc(mci_pkg::BOOT_LCC,              mci_pkg::BOOT_BREAKPOINT);
+            arc(mci_pkg::BOOT_BREAKPOINT,       mci_pkg::BOOT_MCU);
+            arc(mci_pkg::BOOT_MCU,              mci_pkg::BOOT_WAIT_CLPA_GO);
+            arc(mci_pkg::BOOT_MCU,              mci_pkg::BOOT_WAIT_MCU_RST_REQ);
+            arc(mci_pkg::BOOT_WAIT_CLPA_GO,     mci_pkg::BOOT_CPTRA);
+            arc(mci_pkg::BOOT_CPTRA,            mci_pkg::BOOT_WAIT_MCU_RST_REQ);
+            arc(mci_pkg::BOOT_WAIT_MCU_RST_REQ, mci_pkg::BOOT_RST_MCU);
+            arc(mci_pkg::BOOT_RST_MCU,          mci_pkg::BOOT_MCU);
+
+            // Life cycle states a transition can target, all but RAW
+            lc_st = lc_ctrl_state_pkg::DecLcStRaw;
+            for (lc_st = lc_st.next(); lc_st != lc_ctrl_state_pkg::DecLcStPostTrans; lc_st = lc_st.next())
+                void'(func_cov_bin(ctx, $sformatf("lc_target.%s", lc_name(lc_st))));
+
+            // Partitions behind the DAI; the life cycle partition is written by the LCI
+            for (int i = 0; i < int'(otp_ctrl_part_pkg::LifeCycleIdx); i++)
+                void'(func_cov_bin(ctx, $sformatf("fuse_prog.%s", otp_ctrl_part_pkg::part_idx_e'(i).name())));
+        end
+    end
+
+    always @(posedge clk) begin
+        if (!rst_l) begin
+            boot_fsm_d         <= mci_pkg::BOOT_IDLE;
+            lc_trans_success_d <= 1'b0;
+            lc_from            <= lc_ctrl_state_pkg::DecLcStRaw;
+            cptra_wr_addr_vld  <= 1'b0;
+            mci_wr_addr_vld    <= 1'b0;
+        end
+        else if (ctx != null) begin
+            boot_fsm_d         <= boot_fsm;
+            lc_trans_success_d <= lc_trans_success;
+
+            if (boot_fsm != boot_fsm_d)
+                func_cov_sample(ctx, $sformatf("boot_fsm.%s->%s", boot_fsm_d.name(), boot_fsm.name()));
+
+            if (lc_trans_cmd && lc_state != lc_ctrl_state_pkg::DecLcStPostTrans)
+                lc_from <= lc_state;
+            if (lc_trans_success && !lc_trans_success_d) begin
+                func_cov_sample(ctx, $sformatf("lc_trans.%s->%s", lc_name(lc_from), lc_name(lc_target)));
+                func_cov_sample(ctx, $sformatf("lc_target.%s", lc_name(lc_target)));
+            end
+
+            if (fuse_dai_wr)
+                func_cov_sample(ctx, $sformatf("fuse_prog.%s", otp_ctrl_part_pkg::part_idx_e'(fuse_dai_part).name()));
+
+            // Register writes: latch AW, match on the W handshake
+            if (cptra_awvalid && cptra_awready) begin
+                cptra_wr_addr     <= cptra_awaddr;
+                cptra_wr_addr_vld <= 1'b1;
+            end
+            if (cptra_wvalid && cptra_wready) begin
+                automatic logic [31:0] addr = (cptra_awvalid && cptra_awready) ? cptra_awaddr : cptra_wr_addr;
+                if ((cptra_wr_addr_vld || (cptra_awvalid && cptra_awready)) && addr == `SOC_MBOX_CSR_MBOX_CMD)
+                    func_cov_sample(ctx, $sformatf("cptra_mbox_cmd.0x%08x", cptra_wdata));
+                if (!(cptra_awvalid && cptra_awready))
+                    cptra_wr_addr_vld <= 1'b0;
+            end
+
+            if (mci_awvalid && mci_awready) begin
+                mci_wr_addr     <= mci_awaddr;
+                mci_wr_addr_vld <= 1'b1;
+            end
+            if (mci_wvalid && mci_wready) begin
+                automatic logic [31:0] addr = (mci_awvalid && mci_awready) ? mci_awaddr : mci_wr_addr;
+                if (mci_wr_addr_vld || (mci_awvalid && mci_awready)) begin
+                    if (addr == MCI_MBOX0_CMD) func_cov_sample(ctx, $sformatf("mcu_mbox0_cmd.0x%08x", mci_wdata));
+                    if (addr == MCI_MBOX1_CMD) func_cov_sample(ctx, $sformatf("mcu_mbox1_cmd.0x%08x", mci_wdata));
+                end
+                if (!(mci_awvalid && mci_awready))
+                    mci_wr_addr_vld <= 1'b0;
+            end
+
+            // Console characters are printable or CR/LF, the rest are commands
+            if (mailbox_write && !(mailbox_data[7:0] inside {8'h0a, 8'h0d, [8'h20:8'h7e]}))
+                func_cov_sample(ctx, $sformatf("tb_cmd.0x%02x", mailbox_data[7:0]));
+        end
+    end
+
+    final begin
+        if (ctx != null) func_cov_close(ctx);
+    end
+
+endmodule
@@ -0,0 +1,365 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// I3C controller for the recovery flow
+//
+// License-free stand-in for the Avery I3C VIP, used when the TB is built
+// without AVERY_I3C. It is a bit-level SDR controller that acts as the BMC in
+// the OCP streaming boot flow:
+//   1. SETDASA, static address of the recovery target -> dynamic address
+//   2. DEVICE_STATUS (36) reads until the device reports recovery mode (0x3)
+//   3. RECOVERY_CTRL (38) = {CMS 0, image from memory window, no activation}
+//   4. INDIRECT_FIFO_CTRL (45) = {CMS 0, reset, image size in 4 byte words}
+//   5. The image in INDIRECT_FIFO_DATA (47) writes of up to +I3C_REC_CHUNK
+//      bytes. A NACKed address header means the FIFO is full, the write is
+//      retried after +I3C_POLL_CYCLES
+//   6. RECOVERY_CTRL (38) = {CMS 0, image from memory window, activate}
+// Every recovery command carries the SMBus PEC (CRC-8) like the Avery test.
+// The stream throughput is printed when the image is written.
+//
+// The flow starts on STDOUT command 0x8D from the firmware, or right after
+// reset with +I3C_REC_START.
+//
+// Run time knobs:
+//   +I3C_REC_IMAGE=<file>     recovery image, $readmemh/objcopy -O verilog
+//                             bytes with @address records
+//   +I3C_REC_BYTES=<n>        image of n bytes of counting pattern when no
+//                             file is given (default 4096)
+//   +I3C_SDR_KHZ=<khz>        SCL rate (default 12500, the SDR maximum)
+//   +I3C_REC_CHUNK=<n>        bytes per INDIRECT_FIFO_DATA write (default 256)
+//   +I3C_REC_ADDR=<hex>       static address of the recovery target (default 5B)
+//   +I3C_REC_DYN_ADDR=<hex>   dynamic address assigned to it (default 5B)
+//   +I3C_NO_DAA               skip SETDASA and use the static address
+//   +I3C_POLL_CYCLES=<n>      wait between status polls and retries (default 2000)
+
+module css_i3c_ctrl #(
+    parameter int CoreClkMhz = 1000
+) (
+    input  logic        clk,
+    input  logic        rst_l,
+    input  logic        mailbox_write,
+    input  logic [31:0] mailbox_data,
+    // Bus, wired-AND of all devices, 1 = released
+    input  logic        scl_i,
+    input  logic        sda_i,
+    output logic        scl_o,
+    output logic        sda_o,
+    output logic        done
+);
+
+    localparam logic [6:0] BCAST_ADDR = 7'h7E;
+    localparam logic [7:0] CCC_SETDASA = 8'h87;
+
+    // OCP recovery commands
+    localparam logic [7:0] CMD_DEVICE_STATUS      = 8'd36;
+    localparam logic [7:0] CMD_RECOVERY_CTRL      = 8'd38;
+    localparam logic [7:0] CMD_INDIRECT_FIFO_CTRL = 8'd45;
+    localparam logic [7:0] CMD_INDIRECT_FIFO_DATA = 8'd47;
+
+    int unsigned half;              // SCL half period in clk cycles
+    int unsigned sdr_khz;
+    int unsigned chunk;
+    int unsigned poll_cycles;
+    logic [6:0]  static_addr;
+    logic [6:0]  addr;
+    byte unsigned img [$];
+    int unsigned nacks;
+
+    task automatic tick(int unsigned n);
+        repeat (n) @(posedge clk);
+    endtask
+
+    //=========================================================================
+    // Bus primitives, all entered and left with SCL low unless noted
+    //=========================================================================
+
+    // From a free bus
+    task automatic start_cond();
+        sda_o = 1'b0;
+        tick(half);
+        scl_o = 1'b0;
+    endtask
+
+    task automatic repeated_start();
+        tick(half / 2);
+        sda_o = 1'b1;
+        tick(half - half / 2);
+        scl_o = 1'b1;
+        tick(half);
+        sda_o = 1'b0;
+        tick(half);
+        scl_o = 1'b0;
+    endtask
+
+    // Leaves the bus free
+    task automatic stop_cond();
+        tick(half / 2);
+        sda_o = 1'b0;
+        tick(half - half / 2);
+        scl_o = 1'b1;
+        tick(half);
+        sda_o = 1'b1;
+        tick(2 * half);
+    endtask
+
+    // One SCL pulse, SDA set mid low phase, sampled at the end of the high phase
+    task automatic clock_bit(input logic b, output logic s);
+        tick(half / 2);
+        sda_o = b;
+        tick(half - half / 2);
+        scl_o = 1'b1;
+        tick(half);
+        s = sda_i;
+        scl_o = 1'b0;
+    endtask
+
+    // Address header, returns 1 on ACK
+    task automatic send_header(input logic [6:0] a, input logic rnw, output logic ack);
+        logic [7:0] b = {a, rnw};
+        logic       s;
+        for (int i = 7; i >= 0; i--) clock_bit(b[i], s);
+        clock_bit(1'b1, s);
+        ack = !s;
+    endtask
+
+    // Data byte and T bit (odd parity)
+    task automatic send_byte(input logic [7:0] b);
+        logic s;
+        for (int i = 7; i >= 0; i--) clock_bit(b[i], s);
+        clock_bit(~^b, s);
+    endtask
+
+    // Data byte and the target's T bit (1: more data follows). With last
+    // set, a transfer the target would continue is ended by the controller.
+    task automatic read_byte(input logic last, output logic [7:0] b, output logic more);
+        logic s;
+        for (int i = 7; i >= 0; i--) begin
+            clock_bit(1'b1, s);
+            b[i] = s;
+        end
+        tick(half);
+        scl_o = 1'b1;
+        tick(half / 2);
+        more = sda_i;
+        if (last && more) sda_o = 1'b0;
+        tick(half - half / 2);
+        scl_o = 1'b0;
+    endtask
+
+    function automatic logic [7:0] crc8(logic [7:0] crc, logic [7:0] d);
+        crc ^= d;
+        for (int i = 0; i < 8; i++) crc = crc[7] ? (crc << 1) ^ 8'h07 : crc << 1;
+        return crc;
+    endfunction
+
+    //=========================================================================
+    // Transfers
+    //=========================================================================
+
+    // START, 7E/W, then Sr and the target header
+    task automatic open_xfer(input logic [6:0] a, output logic ack);
+        start_cond();
+        send_header(BCAST_ADDR, 1'b0, ack);
+        if (!ack) begin
+            stop_cond();
+            return;
+        end
+        repeated_start();
+        send_header(a, 1'b0, ack);
+        if (!ack) stop_cond();
+    endtask
+
+    task automatic setdasa(output logic ack);
+        start_cond();
+        send_header(BCAST_ADDR, 1'b0, ack);
+        if (ack) begin
+            send_byte(CCC_SETDASA);
+            repeated_start();
+            send_header(static_addr, 1'b0, ack);
+            if (ack) send_byte({addr, 1'b0});
+        end
+        stop_cond();
+    endtask
+
+    // Recovery command write: cmd, length, data, PEC. Returns 0 on NACK.
+    task automatic rec_write(input logic [7:0] cmd, input byte unsigned data [$], output logic ack);
+        logic [7:0] pec;
+        open_xfer(addr, ack);
+        if (!ack) return;
+        pec = crc8(8'h00, {addr, 1'b0});
+        pec = crc8(pec, cmd);
+        pec = crc8(pec, 8'(data.size()));
+        pec = crc8(pec, 8'(data.size() >> 8));
+        send_byte(cmd);
+        send_byte(8'(data.size()));
+        send_byte(8'(data.size() >> 8));
+        foreach (data[i]) begin
+            send_byte(data[i]);
+            pec = crc8(pec, data[i]);
+        end
+        send_byte(pec);
+        stop_cond();
+    endtask
+
+    // Recovery command read: cmd and PEC, Sr, then length, data and PEC
+    task automatic rec_read(input logic [7:0] cmd, input int len, output byte unsigned data [$], output logic ack);
+        logic [7:0] b;
+        logic       more;
+        data = {};
+        open_xfer(addr, ack);
+        if (!ack) return;
+        send_byte(cmd);
+        send_byte(crc8(crc8(8'h00, {addr, 1'b0}), cmd));
+        repeated_start();
+        send_header(addr, 1'b1, ack);
+        if (ack) begin
+            for (int i = 0; i < len + 3; i++) begin
+                read_byte(i == len + 2, b, more);
+                if (i >= 2 && i < len + 2) data.push_back(b);
+                if (!more) break;
+            end
+        end
+        stop_cond();
+    endtask
+
+    //=========================================================================
+    // Image
+    //=========================================================================
+
+    task automatic load_image();
+        string       path;
+        string       tok;
+        int          fd;
+        int unsigned a;
+        int unsigned v;
+        int unsigned n;
+
+        if ($value$plusargs("I3C_REC_IMAGE=%s", path)) begin
+            fd = $fopen(path, "r");
+            if (fd == 0) begin
+                $error("I3C ctrl: Unable to open %s", path);
+                return;
+            end
+            a = 0;
+            while ($fscanf(fd, "%s", tok) == 1) begin
+                if (tok.substr(0, 0) == "@") begin
+                    void'($sscanf(tok.substr(1, tok.len() - 1), "%h", a));
+                    continue;
+                end
+                void'($sscanf(tok, "%h", v));
+                while (img.size() <= a) img.push_back(8'h00);
+                img[a++] = 8'(v);
+            end
+            $fclose(fd);
+        end
+        else begin
+            if (!$value$plusargs("I3C_REC_BYTES=%d", n)) n = 4096;
+            for (int unsigned i = 0; i < n; i++) img.push_back(8'(i));
+        end
+        // The FIFO takes 4 byte words
+        while (img.size() % 4) img.push_back(8'h00);
+    endtask
+
+    //=========================================================================
+    // Recovery flow
+    //=========================================================================
+
+    logic start_req;
+
+    always @(posedge clk or negedge rst_l) begin
+        if (!rst_l) start_req <= 1'b0;
+        else if (mailbox_write && mailbox_data[7:0] == 8'h8D) start_req <= 1'b1;
+    end
+
+    task automatic run_recovery();
+        byte unsigned d [$];
+        logic         ack;
+        int unsigned  polls;
+        realtime      rt0, rt1;
+        real          us, kbs;
+
+        if (!$test$plusargs("I3C_NO_DAA")) begin
+            do begin
+                setdasa(ack);
+                if (!ack) tick(poll_cycles);
+            end while (!ack);
+            $display("[%0t] I3C ctrl: SETDASA %h -> %h", $time, static_addr, addr);
+        end
+
+        // Wait for recovery mode
+        polls = 0;
+        do begin
+            rec_read(CMD_DEVICE_STATUS, 4, d, ack);
+            polls++;
+            if (!ack || d.size() == 0 || d[0] != 8'h03) tick(poll_cycles);
+        end while (!ack || d.size() == 0 || d[0] != 8'h03);
+        $display("[%0t] I3C ctrl: device in recovery mode after %0d DEVICE_STATUS reads", $time, polls);
+
+        do rec_write(CMD_RECOVERY_CTRL, {8'h00, 8'h00, 8'h00}, ack); while (!ack);
+        d = {8'h00, 8'h01, 8'(img.size() / 4), 8'(img.size() / 4 >> 8), 8'(img.size() / 4 >> 16), 8'(img.size() / 4 >> 24)};
+        do rec_write(CMD_INDIRECT_FIFO_CTRL, d, ack); while (!ack);
+
+        rt0 = $realtime;
+        nacks = 0;
+        for (int unsigned off = 0; off < img.size(); off += chunk) begin
+            int unsigned n = img.size() - off < chunk ? img.size() - off : chunk;
+            d = {};
+            for (int unsigned i = 0; i < n; i++) d.push_back(img[off + i]);
+            forever begin
+                rec_write(CMD_INDIRECT_FIFO_DATA, d, ack);
+                if (ack) break;
+                nacks++;
+                tick(poll_cycles);
+            end
+        end
+        rt1 = $realtime;
+
+        do rec_write(CMD_RECOVERY_CTRL, {8'h00, 8'h00, 8'h01}, ack); while (!ack);
+
+        us  = (rt1 - rt0) / 1us;
+        kbs = us > 0 ? img.size() / us * 1000.0 : 0.0;
+        $display("[%0t] I3C ctrl: %0d byte image written in %0.1f us, %0.1f kB/s at SCL %0d kHz, %0d byte writes, %0d NACK retries",
+                 $time, img.size(), us, kbs, sdr_khz, chunk, nacks);
+    endtask
+
+    initial begin
+        int unsigned a;
+
+        scl_o = 1'b1;
+        sda_o = 1'b1;
+        done  = 1'b0;
+
+        if (!$value$plusargs("I3C_SDR_KHZ=%d", sdr_khz) || sdr_khz == 0) sdr_khz = 12500;
+        half = CoreClkMhz * 1000 / (2 * sdr_khz);
+        if (half < 2) half = 2;
+        if (!$value$plusargs("I3C_REC_CHUNK=%d", chunk)) chunk = 256;
+        chunk = chunk < 4 ? 4 : chunk > 256 ? 256 : chunk & ~3;
+        if (!$value$plusargs("I3C_POLL_CYCLES=%d", poll_cycles)) poll_cycles = 2000;
+        static_addr = 7'h5B;
+        if ($value$plusargs("I3C_REC_ADDR=%h", a)) static_addr = 7'(a);
+        addr = static_addr;
+        if ($value$plusargs("I3C_REC_DYN_ADDR=%h", a)) addr = 7'(a);
+        if ($test$plusargs("I3C_NO_DAA")) addr = static_addr;
+
+        wait (rst_l === 1'b1);
+        if (!$test$plusargs("I3C_REC_START")) wait (start_req);
+        load_image();
+        $display("[%0t] I3C ctrl: recovery stream of %0d bytes to target %h, SCL %0d kHz",
+                 $time, img.size(), addr, sdr_khz);
+        run_recovery();
+        done = 1'b1;
+    end
+
+endmodule
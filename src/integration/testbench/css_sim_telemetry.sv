@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Simulation speed telemetry
+//
+// Samples host wall clock time, simulated time, cycleCnt and the MCU and
+// Caliptra core retired instruction counts every +TELEMETRY_EVERY=<cycles>
+// (default 100000) into sim_telemetry.jsonl (sim_telemetry.c). The run is
+// split into phases at these boundaries:
+//   reset      - time zero to TB reset release
+//   css_boot   - MCI boot sequencer, until the MCU leaves reset
+//   mcu_fw     - MCU running, until the Caliptra core leaves reset
+//   cptra_rom  - Caliptra core ROM, until ready_for_mb_processing
+//   cptra_rt   - after ready_for_mb_processing
+//   fw_marker_<n> - from each firmware boot marker (STDOUT command 0x86)
+//   end_wait   - from the end of test command (0xFF/0x01) to $finish, e.g.
+//                the I3C test wait
+// The per phase host time, cycles/s and KIPS are printed at the end of the
+// simulation and written to the timeline. +NO_TELEMETRY turns it off.
+
+module css_sim_telemetry
+    import sim_telemetry_pkg::*;
+(
+    input logic         clk,
+    input logic         rst_l,
+    input int           cycleCnt,
+    input logic         mailbox_write,
+    input logic [31:0]  mailbox_data,
+    input logic         mcu_rst_b,
+    input logic         cptra_rst_b,
+    input logic         ready_for_mb_processing,
+    input logic [31:0]  mcu_instret,
+    input logic [31:0]  cptra_instret
+);
+
+    chandle      ctx;
+    int unsigned every;
+    int unsigned next_sample;
+    bit          mcu_rst_b_d, cptra_rst_b_d, ready_d, end_seen;
+
+    function automatic void phase(string name);
+        sim_telemetry_phase(ctx, name, cycleCnt, $realtime / 1ns, mcu_instret, cptra_instret);
+    endfunction
+
+    initial begin
+        if (!$test$plusargs("NO_TELEMETRY")) begin
+            if (!$value$plusargs("TELEMETRY_EVERY=%d", every) || every == 0) every = 100000;
+            ctx = sim_telemetry_open("sim_telemetry.jsonl");
+            if (ctx != null) phase("reset");
+        end
+    end
+
+    always @(posedge rst_l) begin
+        if (ctx != null) phase("css_boot");
+    end
+
+    always @(posedge clk) begin
+        if (ctx != null && rst_l) begin
+            mcu_rst_b_d   <= mcu_rst_b;
+            cptra_rst_b_d <= cptra_rst_b;
+            ready_d       <= ready_for_mb_processing;
+
+            if (mcu_rst_b && !mcu_rst_b_d)                     phase("mcu_fw");
+            if (cptra_rst_b && !cptra_rst_b_d)                 phase("cptra_rom");
+            if (ready_for_mb_processing && !ready_d)           phase("cptra_rt");
+            if (mailbox_write && mailbox_data[7:0] == 8'h86)   phase($sformatf("fw_marker_%0d", mailbox_data[15:8]));
+            if (mailbox_write && !end_seen && (mailbox_data[7:0] == 8'hff || mailbox_data[7:0] == 8'h01)) begin
+                end_seen <= 1'b1;
+                phase("end_wait");
+            end
+
+            if (cycleCnt >= next_sample) begin
+                next_sample <= cycleCnt + every;
+                sim_telemetry_sample(ctx, cycleCnt, $realtime / 1ns, mcu_instret, cptra_instret);
+            end
+        end
+    end
+
+    final begin
+        if (ctx != null) begin
+            sim_telemetry_close(ctx, cycleCnt, $realtime / 1ns, mcu_instret, cptra_instret);
+            $display("Simulation speed timeline in \"sim_telemetry.jsonl\"");
+        end
+    end
+
+endmodule
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Waveform dump control
+//
+// Decides when the waveform is dumped, so long tests only pay for tracing
+// in the window of interest. dump_en follows the triggers below; the TB
+// turns it into $dumpon/$dumpoff, the Verilator harness into dump calls
+// (tb_wave_ctl()), which also implements the scope list and the ring dump.
+//
+// Start triggers, any of
+//   +WAVE_START=<cycle>       core_clk cycle
+//   +WAVE_PC=<hex>            first MCU instruction retired at this PC
+//   +WAVE_COND                rising edge of cond (the TB's WAVE_COND define)
+//   STDOUT command 0x8E       data[8] = 1 from the firmware; +WAVE_FW when
+//                             this is the only start trigger
+// Stop triggers, any of
+//   +WAVE_STOP=<cycle>        core_clk cycle
+//   +WAVE_PC_STOP=<hex>       MCU instruction retired at this PC
+//   +WAVE_CYCLES=<n>          n cycles after the last start
+//   STDOUT command 0x8E       data[8] = 0 from the firmware
+// Dumping starts at time zero when no start trigger is given.
+//
+// Harness only (test_caliptra_ss_top_tb.cpp):
+//   +WAVE_SCOPE=<a,b,..>      dump only these scopes, relative to the TB top,
+//                             e.g. caliptra_ss_dut.mci_top_i
+//   +WAVE_RING=<cycles>       keep only the last <cycles>..2*<cycles> cycles
+//                             in two alternating files, wave_ring_{0,1}.*,
+//                             deleted when the test passes unless
+//                             +WAVE_RING_KEEP is given
+
+module css_wave_ctl (
+    input  logic        clk,
+    input  logic        rst_l,
+    input  int          cycleCnt,
+    input  logic        mailbox_write,
+    input  logic [31:0] mailbox_data,
+    input  logic        commit,
+    input  logic [31:0] pc,
+    input  logic        cond,
+    output logic        dump_en
+);
+
+    int unsigned start_cycle, stop_cycle, max_cycles;
+    logic [31:0] start_pc, stop_pc;
+    bit          start_cycle_en, stop_cycle_en, start_pc_en, stop_pc_en, cond_en;
+    bit          start_pc_seen;
+    logic        cond_d;
+    int unsigned on_cycles;
+
+    initial begin
+        start_cycle_en = $value$plusargs("WAVE_START=%d", start_cycle);
+        stop_cycle_en  = $value$plusargs("WAVE_STOP=%d", stop_cycle);
+        start_pc_en    = $value$plusargs("WAVE_PC=%h", start_pc);
+        stop_pc_en     = $value$plusargs("WAVE_PC_STOP=%h", stop_pc);
+        cond_en        = $test$plusargs("WAVE_COND");
+        if (!$value$plusargs("WAVE_CYCLES=%d", max_cycles)) max_cycles = 0;
+        // Firmware controlled dumps start off
+        dump_en = !(start_cycle_en || start_pc_en || cond_en || $test$plusargs("WAVE_FW"));
+    end
+
+    always @(posedge clk) begin
+        logic start, stop;
+
+        cond_d <= cond;
+        start = 1'b0;
+        stop  = 1'b0;
+
+        if (start_cycle_en && cycleCnt == start_cycle) start = 1'b1;
+        if (start_pc_en && !start_pc_seen && commit && pc == start_pc) begin
+            start_pc_seen <= 1'b1;
+            start = 1'b1;
+        end
+        if (cond_en && cond && !cond_d) start = 1'b1;
+        if (rst_l && mailbox_write && mailbox_data[7:0] == 8'h8E) begin
+            if (mailbox_data[8]) start = 1'b1;
+            else                 stop  = 1'b1;
+        end
+
+        if (stop_cycle_en && cycleCnt == stop_cycle) stop = 1'b1;
+        if (stop_pc_en && commit && pc == stop_pc) stop = 1'b1;
+        if (max_cycles != 0 && dump_en && on_cycles >= max_cycles) stop = 1'b1;
+
+        if (start && !dump_en) begin
+            dump_en   <= 1'b1;
+            on_cycles <= 0;
+            $display("[%0t] Wave dump on at cycle %0d", $time, cycleCnt);
+        end
+        else if (stop && dump_en) begin
+            dump_en <= 1'b0;
+            $display("[%0t] Wave dump off at cycle %0d", $time, cycleCnt);
+        end
+        else if (dump_en) begin
+            on_cycles <= on_cycles + 1;
+        end
+    end
+
+endmodule
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// MCU hang detector
+//
+// Fails the test early when the MCU makes no progress, typically firmware
+// spinning on a status register that never changes. The MCU counts as making
+// progress when, since the last progress point, it
+//   - retired an instruction outside a WindowBytes wide PC window
+//   - retired a store/AMO
+//   - took an exception or interrupt
+//   - issued an AXI write on the LSU port
+//   - got AXI read data different from the previous read beat on the LSU port
+// A poll loop re-reading an unchanged value meets none of these. After
+// +HANG_CYCLES=<n> core clocks without progress (default 2_000_000, 0 disables)
+// the last HistDepth retired instructions and the MCU AXI outstanding state
+// are printed and the test fails. Cycles with the MCU in reset are not counted.
+// Tests with legitimately long polls (e.g. waiting on Caliptra FW) can raise
+// +HANG_CYCLES or pass +NO_HANG_DETECT.
+
+module mcu_hang_mon #(
+    parameter int HistDepth   = 32,
+    parameter int WindowBytes = 256
+) (
+    input logic         clk,
+    input logic         rst_l,
+    input logic         mcu_rst_b,
+    input int           cycleCnt,
+
+    // MCU retire trace
+    input logic         commit,
+    input logic [31:0]  pc,
+    input logic [31:0]  insn,
+    input logic         exception,
+    input logic         interrupt,
+
+    // MCU LSU AXI manager
+    input logic         lsu_awvalid,
+    input logic         lsu_awready,
+    input logic [31:0]  lsu_awaddr,
+    input logic         lsu_bvalid,
+    input logic         lsu_bready,
+    input logic         lsu_arvalid,
+    input logic         lsu_arready,
+    input logic [31:0]  lsu_araddr,
+    input logic         lsu_rvalid,
+    input logic         lsu_rready,
+    input logic         lsu_rlast,
+    input logic [63:0]  lsu_rdata,
+
+    // MCU IFU AXI manager
+    input logic         ifu_arvalid,
+    input logic         ifu_arready,
+    input logic [31:0]  ifu_araddr,
+    input logic         ifu_rvalid,
+    input logic         ifu_rready,
+    input logic         ifu_rlast
+);
+
+    int unsigned  hang_cycles;
+    int unsigned  idle_cycles;
+    bit           hang_reported;
+
+    // PC window of the current loop
+    logic [31:0]  win_lo, win_hi;
+    bit           win_valid;
+
+    // Retired instruction history (ring buffer)
+    int           hist_cycle [HistDepth];
+    logic [31:0]  hist_pc    [HistDepth];
+    logic [31:0]  hist_insn  [HistDepth];
+    int unsigned  hist_wr;
+
+    // AXI state
+    int           lsu_wr_outstanding, lsu_rd_outstanding, ifu_rd_outstanding;
+    logic [31:0]  lsu_last_araddr, lsu_last_awaddr, ifu_last_araddr;
+    logic [63:0]  lsu_last_rdata;
+    bit           lsu_rdata_valid;
+
+    initial begin
+        if ($test$plusargs("NO_HANG_DETECT")) hang_cycles = 0;
+        else if (!$value$plusargs("HANG_CYCLES=%d", hang_cycles)) hang_cycles = 2_000_000;
+        if (hang_cycles != 0)
+            $display("MCU hang detector: fail after %0d cycles without progress", hang_cycles);
+    end
+
+    // Stores: STORE, STORE-FP, AMO, and c.sw/c.swsp/c.fsw/c.fswsp
+    function automatic bit is_store(logic [31:0] i);
+        if (i[1:0] == 2'b11)
+            return i[6:0] inside {7'b0100011, 7'b0100111, 7'b0101111};
+        return i[15:13] inside {3'b110, 3'b111} && i[1:0] inside {2'b00, 2'b10};
+    endfunction
+
+    function automatic bit in_window(logic [31:0] lo, logic [31:0] hi, logic [31:0] a);
+        logic [31:0] nlo, nhi;
+        nlo = a < lo ? a : lo;
+        nhi = a > hi ? a : hi;
+        return nhi - nlo < WindowBytes;
+    endfunction
+
+    task automatic report_hang();
+        int unsigned n;
+
+        $display("\n[%0d] MCU hang detected: no progress for %0d cycles", cycleCnt, idle_cycles);
+        if (win_valid)
+            $display("  PC window     : %h - %h", win_lo, win_hi);
+        else
+            $display("  PC window     : no instruction retired");
+        $display("  LSU AXI       : %0d read(s) outstanding (last araddr %h, rdata %h), %0d write(s) outstanding (last awaddr %h)",
+                 lsu_rd_outstanding, lsu_last_araddr, lsu_last_rdata, lsu_wr_outstanding, lsu_last_awaddr);
+        $display("  IFU AXI       : %0d read(s) outstanding (last araddr %h)",
+                 ifu_rd_outstanding, ifu_last_araddr);
+        n = hist_wr < HistDepth ? hist_wr : HistDepth;
+        $display("  Last %0d retired instructions (cycle : pc insn):", n);
+        for (int unsigned i = hist_wr - n; i != hist_wr; i++)
+            $display("    %10d : %h %h", hist_cycle[i % HistDepth], hist_pc[i % HistDepth], hist_insn[i % HistDepth]);
+    endtask
+
+    always @(posedge clk or negedge rst_l) begin
+        if (!rst_l) begin
+            idle_cycles        <= 0;
+            win_valid          <= 1'b0;
+            hist_wr            <= 0;
+            lsu_wr_outstanding <= 0;
+            lsu_rd_outstanding <= 0;
+            ifu_rd_outstanding <= 0;
+            lsu_rdata_valid    <= 1'b0;
+        end
+        else begin
+            bit progress;
+
+            progress = 1'b0;
+
+            lsu_wr_outstanding <= lsu_wr_outstanding + (lsu_awvalid && lsu_awready) - (lsu_bvalid && lsu_bready);
+            lsu_rd_outstanding <= lsu_rd_outstanding + (lsu_arvalid && lsu_arready) - (lsu_rvalid && lsu_rready && lsu_rlast);
+            ifu_rd_outstanding <= ifu_rd_outstanding + (ifu_arvalid && ifu_arready) - (ifu_rvalid && ifu_rready && ifu_rlast);
+            if (lsu_arvalid && lsu_arready) lsu_last_araddr <= lsu_araddr;
+            if (ifu_arvalid && ifu_arready) ifu_last_araddr <= ifu_araddr;
+            if (lsu_awvalid && lsu_awready) begin
+                lsu_last_awaddr <= lsu_awaddr;
+                progress = 1'b1;
+            end
+            if (lsu_rvalid && lsu_rready) begin
+                if (!lsu_rdata_valid || lsu_rdata !== lsu_last_rdata) progress = 1'b1;
+                lsu_last_rdata  <= lsu_rdata;
+                lsu_rdata_valid <= 1'b1;
+            end
+
+            if (commit) begin
+                hist_cycle[hist_wr % HistDepth] <= cycleCnt;
+                hist_pc   [hist_wr % HistDepth] <= pc;
+                hist_insn [hist_wr % HistDepth] <= insn;
+                hist_wr <= hist_wr + 1;
+                if (exception || interrupt || is_store(insn) || !win_valid || !in_window(win_lo, win_hi, pc)) begin
+                    progress = 1'b1;
+                    win_lo <= pc;
+                    win_hi <= pc;
+                    win_valid <= 1'b1;
+                end
+                else begin
+                    if (pc < win_lo) win_lo <= pc;
+                    if (pc > win_hi) win_hi <= pc;
+                end
+            end
+            else if (progress) begin
+                win_valid <= 1'b0;
+            end
+
+            if (progress || !mcu_rst_b || hang_cycles == 0)
+                idle_cycles <= 0;
+            else
+                idle_cycles <= idle_cycles + 1;
+
+            if (hang_cycles != 0 && idle_cycles >= hang_cycles && !hang_reported) begin
+                hang_reported = 1'b1;
+                report_hang();
+                $error("* TESTCASE FAILED");
+                $finish;
+            end
+        end
+    end
+
+endmodule
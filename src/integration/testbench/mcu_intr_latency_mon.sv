@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// MCU interrupt latency monitor
+//
+// Timestamps every rising edge of a TB-driven external interrupt line (set
+// through the 0x81 STDOUT command) and pairs it with the ISR entry report sent
+// back by firmware:
+//   data[7:0] == 0x84 - ISR entry, data[15:8] = vector, data[31:16] = mcycle[15:0] at entry
+//   data[7:0] == 0x85 - ISR exit,  data[15:8] = vector
+// Latency is measured in core clocks on the mcycle time base, so it covers the
+// PIC gateway/arbitration, fast-redirect and handler prologue up to the point
+// where firmware samples mcycle.
+// Every sample is written to mcu_intr_latency.csv; a min/avg/max summary per
+// priority level and per vector, plus nesting statistics, is printed at the end
+// of simulation.
+
+module mcu_intr_latency_mon #(
+    parameter TOTAL_INT = 255
+) (
+    input logic                                  clk,
+    input logic                                  rst_l,
+    input int                                    cycleCnt,
+    input logic                                  mailbox_write,
+    input logic [31:0]                           mailbox_data,
+    input logic [TOTAL_INT:1]                    ext_int_tb,
+    input logic [31:0]                           mcycle,
+    input logic [TOTAL_INT:0][3:0]               intpriority
+);
+
+    typedef struct {
+        int unsigned count;
+        int unsigned min;
+        int unsigned max;
+        longint unsigned sum;
+    } lat_stat_t;
+
+    logic [TOTAL_INT:1] ext_int_tb_d;
+
+    // Per-vector timestamp of the last rising edge
+    logic [31:0]  raise_mcycle [TOTAL_INT:1];
+    int           raise_cycle  [TOTAL_INT:1];
+    logic [3:0]   raise_prio   [TOTAL_INT:1];
+    bit           raise_open   [TOTAL_INT:1];
+
+    lat_stat_t    vec_stat  [TOTAL_INT:1];
+    lat_stat_t    prio_stat [16];
+    lat_stat_t    all_stat;
+
+    // Active ISR stack (vectors) reconstructed from entry/exit reports
+    int           isr_stack [$];
+    int unsigned  max_depth;
+    int unsigned  preemptions;
+    int unsigned  bad_preemptions;
+    int unsigned  unmatched;
+
+    integer       csv;
+
+    function automatic void stat_add(ref lat_stat_t s, input int unsigned lat);
+        if (s.count == 0 || lat < s.min) s.min = lat;
+        if (s.count == 0 || lat > s.max) s.max = lat;
+        s.sum   += lat;
+        s.count += 1;
+    endfunction
+
+    function automatic string stat_str(lat_stat_t s);
+        return $sformatf("n=%0d min=%0d avg=%0.1f max=%0d", s.count, s.min, real'(s.sum) / s.count, s.max);
+    endfunction
+
+    initial begin
+        csv = $fopen("mcu_intr_latency.csv", "w");
+        $fwrite(csv, "vector,priority,raise_cycle,raise_mcycle,entry_mcycle_lo,latency,depth\n");
+        all_stat  = '{default:0};
+        prio_stat = '{default:'{default:0}};
+        vec_stat  = '{default:'{default:0}};
+        raise_open = '{default:0};
+    end
+
+    // Raise timestamps - sampled on the same edge the TB drives ext_int_tb
+    always @(posedge clk) begin
+        ext_int_tb_d <= ext_int_tb;
+        for (int vec = 1; vec <= TOTAL_INT; vec++) begin
+            if (ext_int_tb[vec] && !ext_int_tb_d[vec]) begin
+                raise_mcycle[vec] <= mcycle;
+                raise_cycle[vec]  <= cycleCnt;
+                raise_prio[vec]   <= intpriority[vec];
+                raise_open[vec]   <= 1'b1;
+            end
+        end
+        if (mailbox_write && rst_l && mailbox_data[7:0] == 8'h84) begin
+            automatic int          vec = mailbox_data[15:8];
+            automatic logic [15:0] lat;
+            if (vec == 0 || vec > TOTAL_INT || !raise_open[vec]) begin
+                $display("[%0d] mcu_intr_latency_mon: ISR entry for vector %0d without a TB raise", cycleCnt, vec);
+                unmatched++;
+            end
+            else begin
+                // Firmware reports the low 16 bits of mcycle; latencies are far shorter
+                lat = mailbox_data[31:16] - raise_mcycle[vec][15:0];
+                if (isr_stack.size() > 0) begin
+                    preemptions++;
+                    if (raise_prio[vec] <= raise_prio[isr_stack[$]]) begin
+                        $display("[%0d] mcu_intr_latency_mon: vector %0d (prio %0d) preempted vector %0d (prio %0d) without higher priority",
+                                 cycleCnt, vec, raise_prio[vec], isr_stack[$], raise_prio[isr_stack[$]]);
+                        bad_preemptions++;
+                    end
+                end
+                isr_stack.push_back(vec);
+                if (isr_stack.size() > max_depth) max_depth = isr_stack.size();
+                stat_add(vec_stat[vec], lat);
+                stat_add(prio_stat[raise_prio[vec]], lat);
+                stat_add(all_stat, lat);
+                raise_open[vec] <= 1'b0;
+                $fwrite(csv, "%0d,%0d,%0d,%0d,%0d,%0d,%0d\n", vec, raise_prio[vec], raise_cycle[vec],
+                        raise_mcycle[vec], mailbox_data[31:16], lat, isr_stack.size());
+            end
+        end
+        if (mailbox_write && rst_l && mailbox_data[7:0] == 8'h85) begin
+            if (isr_stack.size() == 0 || isr_stack[$] != mailbox_data[15:8]) begin
+                $display("[%0d] mcu_intr_latency_mon: ISR exit for vector %0d out of order", cycleCnt, mailbox_data[15:8]);
+                unmatched++;
+            end
+            else begin
+                void'(isr_stack.pop_back());
+            end
+        end
+    end
+
+    final begin
+        if (all_stat.count != 0) begin
+            $display("\n---------------- MCU interrupt latency (core clocks) ----------------");
+            $display("all          : %s", stat_str(all_stat));
+            for (int prio = 0; prio < 16; prio++)
+                if (prio_stat[prio].count != 0)
+                    $display("priority %2d  : %s", prio, stat_str(prio_stat[prio]));
+            for (int vec = 1; vec <= TOTAL_INT; vec++)
+                if (vec_stat[vec].count != 0)
+                    $display("vector %3d   : %s", vec, stat_str(vec_stat[vec]));
+            $display("nesting      : max depth=%0d preemptions=%0d invalid preemptions=%0d unmatched reports=%0d",
+                     max_depth, preemptions, bad_preemptions, unmatched);
+            $display("Per-sample data in \"mcu_intr_latency.csv\"");
+            $display("---------------------------------------------------------------------\n");
+        end
+        $fclose(csv);
+    end
+
+endmodule
@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Verilator main for the Caliptra SS testbench
+//
+// The TB generates its own clocks (--timing), so the harness only advances
+// time from one scheduled time slot to the next. All command line arguments
+// are handed to the model, so TB plusargs work unchanged. SIGINT/SIGTERM
+// stop the run at the next time slot and still run the TB final blocks,
+// which flush the traces and logs. A speed report is printed at the end.
+//
+// Harness plusargs:
+//   +dumpon                   - waveform dump (model built with debug=1)
+//   +WAVE_SCOPE=<a,b,..>      - dump only these scopes, relative to the TB top
+//   +WAVE_RING=<cycles>       - rolling dump of the last cycles, see
+//                               css_wave_ctl.sv for these and the triggers
+//   +SIM_CPUS=<first>         - pin the model threads to CPUs <first>..
+//   +SPEED_REPORT_EVERY=<sec> - also print the speed report periodically
+
+#include <cerrno>
+#include <cstdint>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "verilated.h"
+#if VM_TRACE
+#if VM_TRACE_FST
+#include "verilated_fst_c.h"
+using trace_file = VerilatedFstC;
+static const char *const dump_file = "sim.fst";
+static const char *const dump_ext = ".fst";
+#else
+#include "verilated_vcd_c.h"
+using trace_file = VerilatedVcdC;
+static const char *const dump_file = "sim.vcd";
+static const char *const dump_ext = ".vcd";
+#endif
+#endif
+
+// Model class, V<top module>; the Makefile sets it from $(DUT)
+#ifndef TB_TOP
+#define TB_TOP Vcaliptra_ss_top_tb
+#endif
+#define TB_STR_(x) #x
+#define TB_STR(x) TB_STR_(x)
+#include TB_STR(TB_TOP.h)
+
+// TB core_clk period in ps, see the core_clk generator in caliptra_ss_top_tb.sv
+#ifndef TB_CLK_PERIOD_PS
+#define TB_CLK_PERIOD_PS 1000
+#endif
+
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void on_signal(int sig) {
+  stop_requested = sig;
+  // A second signal kills the run without the final flush
+  std::signal(sig, SIG_DFL);
+}
+
+// Updated by the TB (tb_sim_stats() DPI call) from its final block
+static long long tb_cycles = -1;
+static long long tb_instret = -1;
+
+extern "C" void tb_sim_stats(int cycles, int instret) {
+  tb_cycles = (unsigned)cycles;
+  tb_instret = (unsigned)instret;
+}
+
+// Dump control from css_wave_ctl: 0 off, 1 on, 2 test passed
+static bool wave_on = false;
+static bool wave_passed = false;
+
+extern "C" void tb_wave_ctl(int cmd) {
+  if (cmd == 2)
+    wave_passed = true;
+  else
+    wave_on = cmd != 0;
+}
+
+using wall_clock = std::chrono::steady_clock;
+
+// core_clk cycles to model time units, the TB runs with a 1ps time precision
+static uint64_t cycles_to_ticks(const VerilatedContext *ctx, uint64_t cycles) {
+  double t = (double)cycles * TB_CLK_PERIOD_PS;
+  for (int p = ctx->timeprecision(); p < -12; p++) t *= 10;
+  for (int p = ctx->timeprecision(); p > -12; p--) t /= 10;
+  return t < 1 ? 1 : (uint64_t)t;
+}
+
+static void speed_report(const VerilatedContext *ctx,
+                         wall_clock::time_point t0, const char *tag) {
+  double secs = std::chrono::duration<double>(wall_clock::now() - t0).count();
+  // Simulation time in ps, the TB runs with a 1ps time precision
+  double sim_ps = (double)ctx->time();
+  for (int p = ctx->timeprecision(); p < -12; p++) sim_ps /= 10;
+  for (int p = ctx->timeprecision(); p > -12; p--) sim_ps *= 10;
+  double cycles = tb_cycles >= 0 ? (double)tb_cycles : sim_ps / TB_CLK_PERIOD_PS;
+
+  if (secs <= 0) secs = 1e-9;
+  std::printf("\n%s: %.2f s wall, %.3f us simulated, %.0f core_clk cycles\n", tag,
+              secs, sim_ps * 1e-6, cycles);
+  std::printf("%s: %.1f cycles/s (%.2f kHz), %d thread(s)\n", tag,
+              cycles / secs, cycles / secs / 1e3, (int)ctx->threads());
+  if (tb_instret >= 0)
+    std::printf("%s: MCU %lld instructions retired, %.2f KIPS\n", tag,
+                tb_instret, tb_instret / secs / 1e3);
+  std::fflush(stdout);
+}
+
+#ifdef __linux__
+// Keep the model threads on neighbouring CPUs (same cache/NUMA node). The
+// Verilator worker threads are created with the model and inherit the mask.
+static void pin_threads(int first, int nthreads) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int i = 0; i < nthreads; i++) CPU_SET(first + i, &set);
+  if (sched_setaffinity(0, sizeof(set), &set) != 0)
+    std::fprintf(stderr, "harness: unable to pin to CPUs %d-%d: %s\n", first,
+                 first + nthreads - 1, std::strerror(errno));
+}
+#endif
+
+int main(int argc, char **argv) {
+  const std::unique_ptr<VerilatedContext> ctx{new VerilatedContext};
+  const char *arg;
+
+  ctx->commandArgs(argc, argv);
+  // Console output is line buffered instead of --autoflush, which also
+  // flushed every $fwrite to the trace and log files
+  std::setvbuf(stdout, nullptr, _IOLBF, 0);
+
+  if ((arg = ctx->commandArgsPlusMatch("CHECKPOINT_TESTS=")) && *arg &&
+      ctx->threads() > 1)
+    std::fprintf(stderr,
+                 "harness: WARNING: +CHECKPOINT_TESTS needs a single threaded "
+                 "model, this one runs %d threads\n",
+                 (int)ctx->threads());
+#ifdef __linux__
+  if ((arg = ctx->commandArgsPlusMatch("SIM_CPUS=")) && *arg)
+    pin_threads(std::atoi(arg + std::strlen("+SIM_CPUS=")), ctx->threads());
+#endif
+  double report_every = 0;
+  if ((arg = ctx->commandArgsPlusMatch("SPEED_REPORT_EVERY=")) && *arg)
+    report_every = std::atof(arg + std::strlen("+SPEED_REPORT_EVERY="));
+
+  const std::unique_ptr<TB_TOP> top{new TB_TOP{ctx.get(), "TOP"}};
+
+#if VM_TRACE
+  std::unique_ptr<trace_file> tfp;
+  // Ring dump: two files alternate, each covering ring_ticks of time
+  uint64_t ring_ticks = 0, ring_end = 0;
+  int ring_seg = 0;
+  auto ring_file = [](int seg) { return "wave_ring_" + std::to_string(seg) + dump_ext; };
+  if (((arg = ctx->commandArgsPlusMatch("dumpon")) && *arg) ||
+      ((arg = ctx->commandArgsPlusMatch("WAVE_")) && *arg)) {
+    ctx->traceEverOn(true);
+    tfp.reset(new trace_file);
+    if ((arg = ctx->commandArgsPlusMatch("WAVE_SCOPE=")) && *arg) {
+      // Scopes are relative to the TB top, TOP.<dut>
+      std::string list = arg + std::strlen("+WAVE_SCOPE=");
+      std::string prefix = std::string("TOP.") + (TB_STR(TB_TOP) + 1) + ".";
+      for (size_t pos = 0, end; pos <= list.size(); pos = end + 1) {
+        end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        if (end > pos) tfp->dumpvars(0, prefix + list.substr(pos, end - pos));
+      }
+    }
+    top->trace(tfp.get(), 99);
+    if ((arg = ctx->commandArgsPlusMatch("WAVE_RING=")) && *arg)
+      ring_ticks = cycles_to_ticks(ctx.get(), std::strtoull(arg + std::strlen("+WAVE_RING="), nullptr, 0));
+    if (ring_ticks) {
+      tfp->open(ring_file(ring_seg).c_str());
+      ring_end = ring_ticks;
+    } else {
+      tfp->open(dump_file);
+    }
+  }
+#endif
+
+  std::signal(SIGINT, on_signal);
+  std::signal(SIGTERM, on_signal);
+
+  const auto t0 = wall_clock::now();
+  auto next_report = t0 + std::chrono::duration_cast<wall_clock::duration>(
+                              std::chrono::duration<double>(report_every));
+  unsigned slots = 0;
+  bool idle = false;
+
+  // One eval per time slot; the --timing scheduler knows the next one
+  while (!ctx->gotFinish() && !stop_requested) {
+    top->eval();
+#if VM_TRACE
+    if (tfp && wave_on) {
+      if (ring_ticks && ctx->time() >= ring_end) {
+        tfp->close();
+        ring_seg ^= 1;
+        tfp->open(ring_file(ring_seg).c_str());
+        ring_end = ctx->time() + ring_ticks;
+      }
+      tfp->dump(ctx->time());
+    }
+#endif
+    if (!top->eventsPending()) {
+      idle = true;
+      break;
+    }
+    ctx->time(top->nextTimeSlot());
+    if (report_every > 0 && (++slots & 0xffff) == 0 &&
+        wall_clock::now() >= next_report) {
+      speed_report(ctx.get(), t0, "progress");
+      next_report += std::chrono::duration_cast<wall_clock::duration>(
+          std::chrono::duration<double>(report_every));
+    }
+  }
+
+  if (stop_requested)
+    std::fprintf(stderr, "\nharness: %s at time %lu, stopping\n",
+                 stop_requested == SIGINT ? "SIGINT" : "SIGTERM",
+                 (unsigned long)ctx->time());
+  else if (idle && !ctx->gotFinish())
+    std::fprintf(stderr, "\nharness: no events pending at time %lu, stopping\n",
+                 (unsigned long)ctx->time());
+
+  // Runs the TB final blocks: trace and log flush, tb_sim_stats()
+  top->final();
+#if VM_TRACE
+  if (tfp) {
+    tfp->close();
+    if (ring_ticks && wave_passed && !ctx->commandArgsPlusMatch("WAVE_RING_KEEP")[0]) {
+      std::remove(ring_file(0).c_str());
+      std::remove(ring_file(1).c_str());
+    } else if (ring_ticks) {
+      std::printf("harness: last cycles dumped to %s, the ones before to %s\n",
+                  ring_file(ring_seg).c_str(), ring_file(ring_seg ^ 1).c_str());
+    }
+  }
+#endif
+  speed_report(ctx.get(), t0, "sim speed");
+  std::fflush(nullptr);
+
+  return ctx->gotFinish() ? 0 : 1;
+}
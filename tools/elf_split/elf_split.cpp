@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// MCU firmware ELF to memory image splitter
+//
+// Replaces the per-region `objcopy -O verilog --change-section-lma --pad-to`
+// passes of the firmware build. The linked ELF is mapped once, its PT_LOAD
+// segments are placed by load address into the memory regions of link.ld,
+// and the images of all regions are formatted and written in parallel.
+// Images cover only the loaded bytes: hex files skip gaps with @address
+// records, binary files end at the last loaded byte. Nothing is padded.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Chunk {
+  uint32_t off;  // from the region base
+  const uint8_t *data;
+  uint32_t len;
+};
+
+struct Region {
+  std::string name;
+  uint32_t base;
+  uint32_t size;
+  std::vector<Chunk> chunks;
+  uint32_t bytes = 0;
+  bool ok = true;
+};
+
+// Regions of riscv_hw_if/link.ld and the TB memories they are loaded into
+const Region default_regions[] = {
+    {"mcu_program", 0x80000000u, 0x7FFF * 8, {}},  // .text, MCU ROM (imem)
+    {"mcu_lmem", 0x21200000u, 0x100000, {}},       // .data, MCU SRAM (lmem)
+    {"mcu_dccm", 0x50000000u, 0x4000, {}},         // .dccm, MCU DCCM
+};
+
+struct Options {
+  const char *elf = nullptr;
+  const char *dir = ".";
+  bool binary = false;
+  bool verbose = false;
+  std::vector<Region> regions;
+};
+
+// name=base:size, numbers in C notation
+bool parse_region(const char *arg, Region &r) {
+  const char *eq = strchr(arg, '=');
+  char *end;
+  if (!eq || eq == arg) return false;
+  r.name.assign(arg, eq - arg);
+  r.base = strtoul(eq + 1, &end, 0);
+  if (*end != ':') return false;
+  r.size = strtoul(end + 1, &end, 0);
+  return *end == '\0' && r.size != 0;
+}
+
+void usage() {
+  fprintf(stderr,
+          "Usage: elf_split [options] program.elf\n"
+          "  -r <name>=<base>:<size>  memory region, repeatable; writes <name>.hex/.bin\n"
+          "                           (default: the link.ld regions mcu_program, mcu_lmem,\n"
+          "                           mcu_dccm)\n"
+          "  -b                       raw binary images instead of $readmemh hex\n"
+          "  -o <dir>                 output directory (default .)\n"
+          "  -v                       report loaded bytes outside all regions (e.g. .data.io)\n");
+}
+
+bool parse_args(int argc, char **argv, Options &opt) {
+  int c;
+  while ((c = getopt(argc, argv, "r:bo:vh")) != -1) {
+    switch (c) {
+      case 'r': {
+        Region r;
+        if (!parse_region(optarg, r)) {
+          fprintf(stderr, "elf_split: bad region '%s'\n", optarg);
+          return false;
+        }
+        opt.regions.push_back(r);
+        break;
+      }
+      case 'b': opt.binary = true; break;
+      case 'o': opt.dir = optarg; break;
+      case 'v': opt.verbose = true; break;
+      default: return false;
+    }
+  }
+  if (optind != argc - 1) return false;
+  opt.elf = argv[optind];
+  if (opt.regions.empty())
+    opt.regions.assign(std::begin(default_regions), std::end(default_regions));
+  return true;
+}
+
+// Minimal ELF32 little endian reader: file backed bytes of the PT_LOAD
+// segments, clipped to the regions
+bool place_segments(const uint8_t *img, size_t size, const char *path, bool verbose,
+                    std::vector<Region> &regions) {
+  auto u16 = [&](size_t off) { return (uint32_t)img[off] | ((uint32_t)img[off + 1] << 8); };
+  auto u32 = [&](size_t off) { return u16(off) | (u16(off + 2) << 16); };
+
+  if (size < 52 || memcmp(img, "\x7f" "ELF", 4) || img[4] != 1 || img[5] != 1) {
+    fprintf(stderr, "elf_split: %s is not a little endian ELF32 file\n", path);
+    return false;
+  }
+  uint32_t phoff = u32(28), phentsize = u16(42), phnum = u16(44);
+  if (phentsize < 32 || (size_t)phoff + (size_t)phnum * phentsize > size) {
+    fprintf(stderr, "elf_split: %s: truncated program header table\n", path);
+    return false;
+  }
+  for (uint32_t i = 0; i < phnum; i++) {
+    size_t ph = phoff + (size_t)i * phentsize;
+    if (u32(ph) != 1) continue;  // PT_LOAD
+    uint32_t off = u32(ph + 4), paddr = u32(ph + 12), filesz = u32(ph + 16);
+    if (!filesz) continue;
+    if ((size_t)off + filesz > size) {
+      fprintf(stderr, "elf_split: %s: segment %u is truncated\n", path, i);
+      return false;
+    }
+    uint32_t placed = 0;
+    for (Region &r : regions) {
+      uint64_t lo = std::max<uint64_t>(paddr, r.base);
+      uint64_t hi = std::min<uint64_t>((uint64_t)paddr + filesz, (uint64_t)r.base + r.size);
+      if (lo >= hi) continue;
+      r.chunks.push_back({(uint32_t)(lo - r.base), img + off + (lo - paddr), (uint32_t)(hi - lo)});
+      placed += hi - lo;
+    }
+    if (verbose && placed != filesz)
+      fprintf(stderr, "elf_split: %s: %u of %u bytes at 0x%08x are outside all regions\n", path,
+              filesz - placed, filesz, paddr);
+  }
+  for (Region &r : regions) {
+    std::sort(r.chunks.begin(), r.chunks.end(),
+              [](const Chunk &a, const Chunk &b) { return a.off < b.off; });
+    for (size_t k = 1; k < r.chunks.size(); k++) {
+      const Chunk &p = r.chunks[k - 1];
+      if (r.chunks[k].off < p.off + p.len) {
+        fprintf(stderr, "elf_split: %s: overlapping segments in %s at 0x%08x\n", path,
+                r.name.c_str(), r.base + r.chunks[k].off);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// objcopy -O verilog layout: @offset records, 16 bytes per line
+std::string format_hex(const Region &r) {
+  static const char hex[] = "0123456789ABCDEF";
+  std::string o;
+  uint32_t next = ~0u;
+  size_t total = 0;
+  for (const Chunk &c : r.chunks) total += c.len;
+  o.reserve(total * 3 + r.chunks.size() * 12 + total / 16 + 16);
+  for (const Chunk &c : r.chunks) {
+    if (c.off != next) {
+      char at[16];
+      snprintf(at, sizeof(at), "@%08X\n", c.off);
+      o += at;
+    }
+    for (uint32_t i = 0; i < c.len; i++) {
+      o += hex[c.data[i] >> 4];
+      o += hex[c.data[i] & 0xf];
+      o += ((c.off + i) % 16 == 15 || i == c.len - 1) ? '\n' : ' ';
+    }
+    next = c.off + c.len;
+  }
+  return o;
+}
+
+std::string format_bin(const Region &r) {
+  std::string o;
+  if (r.chunks.empty()) return o;
+  const Chunk &last = r.chunks.back();
+  o.assign(last.off + last.len, '\0');
+  for (const Chunk &c : r.chunks) memcpy(&o[c.off], c.data, c.len);
+  return o;
+}
+
+void write_region(const Options &opt, Region &r) {
+  std::string img = opt.binary ? format_bin(r) : format_hex(r);
+  std::string path = std::string(opt.dir) + "/" + r.name + (opt.binary ? ".bin" : ".hex");
+  for (const Chunk &c : r.chunks) r.bytes += c.len;
+  FILE *f = fopen(path.c_str(), opt.binary ? "wb" : "w");
+  if (!f || fwrite(img.data(), 1, img.size(), f) != img.size()) {
+    fprintf(stderr, "elf_split: Unable to write %s: %s\n", path.c_str(), strerror(errno));
+    r.ok = false;
+  }
+  if (f && fclose(f) != 0) r.ok = false;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse_args(argc, argv, opt)) {
+    usage();
+    return 1;
+  }
+
+  int fd = open(opt.elf, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    fprintf(stderr, "elf_split: Unable to open %s: %s\n", opt.elf, strerror(errno));
+    return 1;
+  }
+  void *map = st.st_size ? mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+  close(fd);
+  if (map == MAP_FAILED) {
+    fprintf(stderr, "elf_split: Unable to map %s: %s\n", opt.elf, strerror(errno));
+    return 1;
+  }
+  if (!place_segments((const uint8_t *)map, st.st_size, opt.elf, opt.verbose, opt.regions)) return 1;
+
+  // One thread per region, each formats its image in memory and writes it
+  // with a single fwrite
+  std::vector<std::thread> pool;
+  for (Region &r : opt.regions) pool.emplace_back(write_region, std::cref(opt), std::ref(r));
+  for (std::thread &t : pool) t.join();
+  munmap(map, st.st_size);
+
+  int rc = 0;
+  for (const Region &r : opt.regions) {
+    printf("elf_split: %-12s 0x%08x: %u bytes in %zu chunk(s)\n", r.name.c_str(), r.base, r.bytes,
+           r.chunks.size());
+    if (!r.ok) rc = 1;
+  }
+  return rc;
+}
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Functional coverage merge
+//
+// Sums the hit tables written by the func_cov DPI library (func_cov.dat,
+// one per run) by bin name, and reports per group how many of the declared
+// bins were hit, the bins never hit and, optionally, every bin as CSV. The
+// merged table has the same layout, so the results of regression shards can
+// be merged again.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include "func_cov.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Bin {
+  std::string name;
+  uint64_t hits = 0;
+  uint64_t runs = 0;
+};
+
+struct Merge {
+  std::vector<Bin> bins;  // in order of first declaration
+  std::unordered_map<std::string, size_t> index;
+  uint64_t runs = 0;
+  unsigned files = 0;
+
+  bool add(const std::string &path);
+};
+
+bool Merge::add(const std::string &path) {
+  auto t = std::make_unique<func_cov_table>();
+  FILE *fp = fopen(path.c_str(), "rb");
+  size_t n = 0;
+
+  if (fp) {
+    n = fread(t.get(), 1, sizeof(func_cov_table), fp);
+    fclose(fp);
+  }
+  if (n != sizeof(func_cov_table) ||
+      memcmp(t->magic, FUNC_COV_MAGIC, sizeof(t->magic)) ||
+      t->version != FUNC_COV_VERSION || t->nbins > FUNC_COV_MAX_BINS) {
+    fprintf(stderr, "func_cov_merge: %s is not a func_cov table, skipped\n",
+            path.c_str());
+    return false;
+  }
+  for (uint32_t i = 0; i < t->nbins; i++) {
+    const func_cov_entry &b = t->bins[i];
+    std::string name(b.name, strnlen(b.name, FUNC_COV_NAME_LEN));
+    auto it = index.find(name);
+    if (it == index.end()) {
+      it = index.emplace(name, bins.size()).first;
+      bins.push_back(Bin{name});
+    }
+    Bin &m = bins[it->second];
+    m.hits += b.hits;
+    m.runs += (t->flags & FUNC_COV_MERGED) ? b.runs : (b.hits != 0);
+  }
+  runs += t->runs;
+  files++;
+  return true;
+}
+
+std::string group_of(const std::string &name) {
+  size_t dot = name.find('.');
+  return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+bool write_table(const Merge &m, const char *path) {
+  auto t = std::make_unique<func_cov_table>();
+
+  memset(t.get(), 0, sizeof(func_cov_table));
+  memcpy(t->magic, FUNC_COV_MAGIC, sizeof(t->magic));
+  t->version = FUNC_COV_VERSION;
+  t->flags = FUNC_COV_MERGED;
+  t->runs = m.runs;
+  if (m.bins.size() > FUNC_COV_MAX_BINS) {
+    fprintf(stderr, "func_cov_merge: %zu bins, only the first %d are written to %s\n",
+            m.bins.size(), FUNC_COV_MAX_BINS, path);
+  }
+  for (const Bin &b : m.bins) {
+    if (t->nbins == FUNC_COV_MAX_BINS) {
+      break;
+    }
+    func_cov_entry &o = t->bins[t->nbins++];
+    snprintf(o.name, sizeof(o.name), "%s", b.name.c_str());
+    o.hits = b.hits;
+    o.runs = b.runs;
+  }
+  FILE *fp = fopen(path, "wb");
+  if (!fp || fwrite(t.get(), sizeof(func_cov_table), 1, fp) != 1) {
+    fprintf(stderr, "func_cov_merge: Unable to write %s\n", path);
+    if (fp) {
+      fclose(fp);
+    }
+    return false;
+  }
+  fclose(fp);
+  return true;
+}
+
+bool write_csv(const Merge &m, const char *path) {
+  FILE *fp = fopen(path, "w");
+
+  if (!fp) {
+    fprintf(stderr, "func_cov_merge: Unable to write %s\n", path);
+    return false;
+  }
+  fprintf(fp, "group,bin,hits,runs\n");
+  for (const Bin &b : m.bins) {
+    std::string g = group_of(b.name);
+    std::string bin = b.name.size() > g.size() ? b.name.substr(g.size() + 1) : "";
+    fprintf(fp, "%s,%s,%llu,%llu\n", g.c_str(), bin.c_str(),
+            (unsigned long long)b.hits, (unsigned long long)b.runs);
+  }
+  fclose(fp);
+  return true;
+}
+
+void report(const Merge &m, bool holes) {
+  struct Group {
+    unsigned bins = 0;
+    unsigned hit = 0;
+  };
+  std::map<std::string, Group> groups;
+  unsigned bins = 0, hit = 0;
+
+  for (const Bin &b : m.bins) {
+    Group &g = groups[group_of(b.name)];
+    g.bins++;
+    g.hit += b.hits != 0;
+  }
+  printf("%llu run(s) in %u table(s)\n\n", (unsigned long long)m.runs, m.files);
+  printf("%-24s %8s %8s %8s\n", "group", "bins", "hit", "cov%");
+  for (const auto &[name, g] : groups) {
+    printf("%-24s %8u %8u %7.1f%%\n", name.c_str(), g.bins, g.hit,
+           100.0 * g.hit / g.bins);
+    bins += g.bins;
+    hit += g.hit;
+  }
+  printf("%-24s %8u %8u %7.1f%%\n", "total", bins, hit,
+         bins ? 100.0 * hit / bins : 0.0);
+  if (holes && hit != bins) {
+    std::vector<const Bin *> missed;
+    for (const Bin &b : m.bins) {
+      if (!b.hits) {
+        missed.push_back(&b);
+      }
+    }
+    std::sort(missed.begin(), missed.end(),
+              [](const Bin *a, const Bin *b) { return a->name < b->name; });
+    printf("\nBins not hit:\n");
+    for (const Bin *b : missed) {
+      printf("  %s\n", b->name.c_str());
+    }
+  }
+}
+
+void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options] <table|dir>...\n"
+          "  Merges func_cov tables; directories are searched for func_cov.dat\n"
+          "  -o <file>  write the merged table\n"
+          "  -c <file>  write every bin as CSV (group,bin,hits,runs)\n"
+          "  -q         do not list the bins that were not hit\n",
+          prog);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *out = nullptr;
+  const char *csv = nullptr;
+  bool holes = true;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "o:c:qh")) != -1) {
+    switch (opt) {
+      case 'o': out = optarg; break;
+      case 'c': csv = optarg; break;
+      case 'q': holes = false; break;
+      default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+    }
+  }
+  if (optind == argc) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  // Sorted so merges of the same runs list bins in the same order
+  std::vector<std::string> paths;
+  for (int i = optind; i < argc; i++) {
+    std::error_code ec;
+    if (fs::is_directory(argv[i], ec)) {
+      for (const auto &e : fs::recursive_directory_iterator(argv[i], ec)) {
+        if (e.is_regular_file() && e.path().filename() == "func_cov.dat" &&
+            (!out || !fs::equivalent(e.path(), out, ec))) {
+          paths.push_back(e.path().string());
+        }
+      }
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+
+  Merge m;
+  for (const std::string &p : paths) {
+    m.add(p);
+  }
+  if (!m.files) {
+    fprintf(stderr, "func_cov_merge: no tables found\n");
+    return 1;
+  }
+  report(m, holes);
+  if ((out && !write_table(m, out)) || (csv && !write_csv(m, csv))) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,275 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Content-hashed build cache for simulator models and test firmware, used by
+# the verilator-build and vcs-build targets of tools/scripts/Makefile when
+# MODEL_CACHE=<dir> is set, and by mcu_program.hex when FW_CACHE=<dir> is set.
+#
+# The key is a hash of
+#   - the contents of every source the file lists (-f, e.g. <DUT>.vf) name,
+#     recursively, and of every file in their +incdir+ and -y directories
+#   - the other file list tokens (+define+, options) and the --src files and
+#     directories
+#   - the build flags (--flags) and the tool versions (--tool commands)
+# File contents are hashed with their base names rather than their paths, and
+# the workspace roots (--root, default $CALIPTRA_SS) are taken out of the flags
+# and file list options, e.g. -I<root>/..., so identical trees in different
+# workspaces share entries. A cache directory on
+# a shared disk serves every user of that disk.
+#
+#   model_cache.py build --cache DIR [key options] --output PATH... -- CMD...
+#       Restores the outputs from DIR/<key> if present, otherwise runs CMD and
+#       stores the outputs there.
+#   model_cache.py key [key options]
+#       Prints the key.
+#   model_cache.py prune --cache DIR --keep N
+#       Keeps the N most recently used entries.
+
+import argparse
+import getpass
+import hashlib
+import json
+import os
+import re
+import shlex
+import shutil
+import socket
+import subprocess
+import sys
+import time
+
+RE_ENV = re.compile(r"\$\{(\w+)\}|\$\((\w+)\)|\$(\w+)")
+
+
+def expand(token):
+    # .vf lists use ${VAR}, Makefiles pass $(VAR)
+    return RE_ENV.sub(lambda m: os.environ.get(m.group(1) or m.group(2) or m.group(3), ""), token)
+
+
+class Hasher:
+    def __init__(self, roots=()):
+        self.h = hashlib.sha256()
+        self.seen_lists = set()
+        self.files = 0
+        # Longest first, so nested roots are replaced by the innermost one
+        self.roots = sorted((os.path.normpath(r) for r in roots if r), key=len, reverse=True)
+
+    def relative(self, s):
+        for r in self.roots:
+            s = re.sub(re.escape(r) + r"(?![\w.-])", "<root>", s)
+        return s
+
+    def text(self, tag, s):
+        self.h.update(("%s:%s\n" % (tag, s)).encode())
+
+    def file(self, path):
+        self.files += 1
+        d = hashlib.sha256()
+        with open(path, "rb") as f:
+            for chunk in iter(lambda: f.read(1 << 20), b""):
+                d.update(chunk)
+        self.text("file", "%s %s" % (os.path.basename(path), d.hexdigest()))
+
+    def path(self, path):
+        if os.path.isfile(path):
+            self.file(path)
+        elif os.path.isdir(path):
+            self.dir(path)
+        else:
+            self.text("missing", os.path.basename(path))
+
+    def dir(self, path):
+        self.text("dir", os.path.basename(os.path.normpath(path)))
+        for name in sorted(os.listdir(path)):
+            p = os.path.join(path, name)
+            if os.path.isfile(p):
+                self.file(p)
+
+    def file_list(self, path):
+        """Hash a -f file list: sources, include dirs and the remaining tokens."""
+        path = os.path.abspath(path)
+        self.text("list", os.path.basename(path))
+        if path in self.seen_lists or not os.path.isfile(path):
+            self.text("missing", os.path.basename(path))
+            return
+        self.seen_lists.add(path)
+        base = os.path.dirname(path)
+        tokens = []
+        with open(path, "r", errors="replace") as f:
+            for line in f:
+                line = line.split("//", 1)[0].strip()
+                if not line or line.startswith("#"):
+                    continue
+                tokens += shlex.split(line, posix=True)
+        it = iter(tokens)
+        for tok in it:
+            tok = expand(tok)
+            if tok in ("-f", "-F", "-v", "-y"):
+                arg = expand(next(it, ""))
+                if not os.path.isabs(arg):
+                    arg = os.path.join(base, arg)
+                if tok in ("-f", "-F"):
+                    self.file_list(arg)
+                else:
+                    self.path(arg)
+            elif tok.startswith("+incdir+"):
+                for d in tok[len("+incdir+"):].split("+"):
+                    if d:
+                        self.path(d if os.path.isabs(d) else os.path.join(base, d))
+            elif tok.startswith(("+", "-")):
+                self.text("opt", self.relative(tok))
+            else:
+                self.path(tok if os.path.isabs(tok) else os.path.join(base, tok))
+
+    def tool(self, cmd):
+        try:
+            out = subprocess.run(cmd, shell=True, stdout=subprocess.PIPE,
+                                 stderr=subprocess.STDOUT, timeout=60).stdout
+        except subprocess.TimeoutExpired:
+            out = b"timeout"
+        self.text("tool", "%s %s" % (cmd, hashlib.sha256(out).hexdigest()))
+
+
+def compute_key(args):
+    h = Hasher(args.root)
+    h.text("flags", h.relative(args.flags))
+    for cmd in args.tool:
+        h.tool(cmd)
+    for vf in args.file_list:
+        h.file_list(vf)
+    for src in args.src:
+        for p in src.split():
+            h.path(p)
+    return h.h.hexdigest()[:32], h.files
+
+
+def copy_out(src, dst):
+    if os.path.isdir(src):
+        if os.path.lexists(dst):
+            shutil.rmtree(dst) if os.path.isdir(dst) and not os.path.islink(dst) else os.remove(dst)
+        shutil.copytree(src, dst, symlinks=True)
+    else:
+        if os.path.dirname(dst):
+            os.makedirs(os.path.dirname(dst), exist_ok=True)
+        if os.path.lexists(dst):
+            os.remove(dst)
+        shutil.copy2(src, dst)
+
+
+def cmd_key(args):
+    key, files = compute_key(args)
+    print(key)
+    print("model_cache: %d files hashed" % files, file=sys.stderr)
+    return 0
+
+
+def cmd_build(args):
+    if not args.cmd or args.cmd[0] != "--" or len(args.cmd) < 2:
+        sys.exit("model_cache: no build command after --")
+    t0 = time.time()
+    key, files = compute_key(args)
+    entry = os.path.join(args.cache, key)
+    print("model_cache: key %s (%d files, %.1f s)" % (key, files, time.time() - t0), flush=True)
+
+    if os.path.isfile(os.path.join(entry, "meta.json")):
+        for out in args.output:
+            copy_out(os.path.join(entry, "out", out), out)
+        # Entry mtime tracks use, for prune
+        os.utime(entry)
+        print("model_cache: hit, restored %s from %s" % (" ".join(args.output), entry), flush=True)
+        return 0
+
+    print("model_cache: miss, building", flush=True)
+    rc = subprocess.call(args.cmd[1:])
+    if rc != 0:
+        return rc
+    missing = [o for o in args.output if not os.path.exists(o)]
+    if missing:
+        print("model_cache: build produced no %s, not cached" % " ".join(missing), file=sys.stderr)
+        return 0
+
+    # Populate a private directory, then publish it with one rename. A
+    # concurrent build of the same key loses the rename and is discarded.
+    os.makedirs(args.cache, exist_ok=True)
+    tmp = "%s.tmp.%s.%d" % (entry, socket.gethostname(), os.getpid())
+    try:
+        for out in args.output:
+            copy_out(out, os.path.join(tmp, "out", out))
+        with open(os.path.join(tmp, "meta.json"), "w") as f:
+            json.dump({"key": key, "outputs": args.output, "flags": args.flags,
+                       "user": getpass.getuser(), "host": socket.gethostname(),
+                       "cwd": os.getcwd(), "date": time.strftime("%Y-%m-%d %H:%M:%S"),
+                       "build_s": round(time.time() - t0, 1)}, f, indent=2)
+        os.rename(tmp, entry)
+        print("model_cache: stored in %s" % entry, flush=True)
+    except OSError as e:
+        print("model_cache: not stored: %s" % e, file=sys.stderr)
+    finally:
+        shutil.rmtree(tmp, ignore_errors=True)
+    return 0
+
+
+def cmd_prune(args):
+    if not os.path.isdir(args.cache):
+        return 0
+    entries = [os.path.join(args.cache, e) for e in os.listdir(args.cache)
+               if os.path.isfile(os.path.join(args.cache, e, "meta.json"))]
+    entries.sort(key=os.path.getmtime, reverse=True)
+    for e in entries[args.keep:]:
+        shutil.rmtree(e, ignore_errors=True)
+        print("model_cache: removed %s" % e)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Content-hashed model and firmware build cache")
+    sub = parser.add_subparsers(dest="action", required=True)
+
+    def key_options(p):
+        p.add_argument("-f", dest="file_list", action="append", default=[],
+                       help="file list (.vf/.vlt), resolved recursively")
+        p.add_argument("--src", action="append", default=[],
+                       help="extra source files or include directories, space separated")
+        p.add_argument("--tool", action="append", default=[],
+                       help="command whose output identifies a tool version")
+        p.add_argument("--flags", default="", help="defines and build flags")
+        p.add_argument("--root", action="append",
+                       default=[os.environ.get("CALIPTRA_SS", "")],
+                       help="workspace root left out of the flags, e.g. -I<root>/...")
+
+    p = sub.add_parser("key", help="print the key")
+    key_options(p)
+    p.set_defaults(func=cmd_key)
+
+    p = sub.add_parser("build", help="restore from the cache or build and store")
+    key_options(p)
+    p.add_argument("--cache", required=True, help="cache directory")
+    p.add_argument("--output", action="append", required=True,
+                   help="build output, relative to the build directory")
+    p.add_argument("cmd", nargs=argparse.REMAINDER, help="-- build command")
+    p.set_defaults(func=cmd_build)
+
+    p = sub.add_parser("prune", help="remove the least recently used entries")
+    p.add_argument("--cache", required=True, help="cache directory")
+    p.add_argument("--keep", type=int, default=20, help="entries to keep")
+    p.set_defaults(func=cmd_prune)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,333 @@
+# SPDX-License-Identifier: Apache-2.0
+#
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Local regression runner for the stimulus YAML lists
+# (src/integration/stimulus/*.yml).
+#
+# The simulator model is built once with tools/scripts/Makefile in
+# <out>/model. Every test and seed then gets its own run directory
+# <out>/<testname>/seed_<seed>, where the firmware is built and the model is
+# run with the "plusargs:" of the test yml, as the Makefile passes them. The
+# runs are spread over a pool of workers. Results go to
+# <out>/summary.json and <out>/junit.xml, and the functional coverage of
+# all runs (func_cov.dat) is merged into <out>/func_cov.csv.
+#
+# Example:
+#   python3 run_regression.py -l $CALIPTRA_SS/src/integration/stimulus/L0_regression.yml \
+#       -t L0 -j 8 --seeds 3 -o regress
+
+import argparse
+import json
+import os
+import random
+import re
+import signal
+import subprocess
+import sys
+import threading
+import time
+import xml.etree.ElementTree as ET
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+import yaml
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+MAKEFILE = os.path.join(SCRIPT_DIR, "Makefile")
+
+# Harness end of run report, see test_caliptra_ss_top_tb.cpp
+RE_SPEED_TIME = re.compile(r"^sim speed: ([\d.]+) s wall, ([\d.]+) us simulated, (\d+) core_clk cycles")
+RE_SPEED_RATE = re.compile(r"^sim speed: ([\d.]+) cycles/s")
+RE_SPEED_KIPS = re.compile(r"^sim speed: MCU (\d+) instructions retired, ([\d.]+) KIPS")
+
+
+def load_list(path, tags):
+    """Return [(testname, seed, plusargs)] of the list entries matching any of
+    tags. plusargs is the "plusargs:" key of the test yml, as a list."""
+    with open(path, "r") as f:
+        data = yaml.full_load(f)
+    tests = []
+    base = os.path.dirname(os.path.abspath(path))
+    for entry in data.get("contents", []):
+        group = entry["tests"]
+        if tags and not set(tags) & set(group.get("tags", [])):
+            continue
+        for p in group.get("paths", []):
+            with open(os.path.join(base, p), "r") as f:
+                test = yaml.full_load(f)
+            tests.append((test["testname"], int(test.get("seed", 1)),
+                          str(test.get("plusargs", "")).split()))
+    return tests
+
+
+def expand_seeds(tests, nseeds, rng):
+    """The YAML seed first, then nseeds - 1 random ones per test."""
+    jobs = []
+    for name, seed, plusargs in tests:
+        seeds = [seed]
+        while len(seeds) < nseeds:
+            s = rng.randrange(1, 1 << 31)
+            if s not in seeds:
+                seeds.append(s)
+        jobs += [(name, s, plusargs) for s in seeds]
+    return jobs
+
+
+def run_logged(cmd, cwd, log, timeout=None, env=None):
+    """Run cmd in its own process group, output to log. Returns (rc, timed_out)."""
+    with open(log, "w") as f:
+        f.write("# cwd: %s\n# cmd: %s\n" % (cwd, " ".join(cmd)))
+        f.flush()
+        p = subprocess.Popen(cmd, cwd=cwd, stdout=f, stderr=subprocess.STDOUT,
+                             env=env, start_new_session=True)
+        try:
+            return p.wait(timeout=timeout), False
+        except subprocess.TimeoutExpired:
+            # SIGTERM first, the harness then still flushes logs and traces
+            os.killpg(p.pid, signal.SIGTERM)
+            try:
+                p.wait(timeout=10)
+            except subprocess.TimeoutExpired:
+                os.killpg(p.pid, signal.SIGKILL)
+                p.wait()
+            return p.returncode, True
+
+
+def parse_sim_log(path, result):
+    passed = failed = False
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            if "* TESTCASE PASSED" in line:
+                passed = True
+            elif "* TESTCASE FAILED" in line:
+                failed = True
+            elif line.startswith("sim speed:"):
+                m = RE_SPEED_TIME.match(line)
+                if m:
+                    result["sim_wall_s"] = float(m.group(1))
+                    result["sim_time_us"] = float(m.group(2))
+                    result["cycles"] = int(m.group(3))
+                m = RE_SPEED_RATE.match(line)
+                if m:
+                    result["cycles_per_s"] = float(m.group(1))
+                m = RE_SPEED_KIPS.match(line)
+                if m:
+                    result["instret"] = int(m.group(1))
+                    result["kips"] = float(m.group(2))
+    return passed and not failed
+
+
+class CpuSlots:
+    """Hands out disjoint CPU ranges to the running simulations (+SIM_CPUS)."""
+
+    def __init__(self, jobs, threads):
+        self.free = [i * threads for i in range(jobs)]
+        self.lock = threading.Lock()
+
+    def get(self):
+        with self.lock:
+            return self.free.pop(0)
+
+    def put(self, cpu):
+        with self.lock:
+            self.free.append(cpu)
+
+
+def run_test(args, model, name, seed, plusargs, cpus):
+    rundir = os.path.join(args.out, name, "seed_%d" % seed)
+    os.makedirs(rundir, exist_ok=True)
+    result = {"test": name, "seed": seed, "rundir": rundir, "status": "error"}
+    t0 = time.time()
+
+    rc, _ = run_logged(["make", "-f", MAKEFILE, "TESTNAME=%s" % name,
+                        "PLAYBOOK_RANDOM_SEED=%d" % seed] + args.make_args +
+                       [args.fw_target], rundir, os.path.join(rundir, "fw_build.log"))
+    if rc != 0:
+        result["message"] = "firmware build failed, see fw_build.log"
+    else:
+        # Same seed for the firmware (PLAYBOOK_RANDOM_SEED) and the model
+        cmd = [model, "+verilator+seed+%d" % seed] + plusargs + args.plusargs
+        cpu = None
+        if cpus:
+            cpu = cpus.get()
+            cmd.append("+SIM_CPUS=%d" % cpu)
+        try:
+            rc, timed_out = run_logged(cmd, rundir, os.path.join(rundir, "sim.log"),
+                                       timeout=args.timeout or None)
+        finally:
+            if cpu is not None:
+                cpus.put(cpu)
+        passed = parse_sim_log(os.path.join(rundir, "sim.log"), result)
+        result["exit_code"] = rc
+        if timed_out:
+            result["status"] = "timeout"
+            result["message"] = "killed after %d s" % args.timeout
+        elif passed and rc == 0:
+            result["status"] = "pass"
+        else:
+            result["status"] = "fail"
+            result["message"] = "exit code %d, see sim.log" % rc
+    result["wall_s"] = round(time.time() - t0, 2)
+    return result
+
+
+def build_model(args):
+    modeldir = os.path.join(args.out, "model")
+    os.makedirs(modeldir, exist_ok=True)
+    model = os.path.join(modeldir, "obj_dir", "V%s" % args.dut)
+    if args.no_build:
+        return model
+    print("Building %s in %s" % (args.dut, modeldir), flush=True)
+    t0 = time.time()
+    rc, _ = run_logged(["make", "-f", MAKEFILE, "DUT=%s" % args.dut] + args.make_args +
+                       ["verilator-build"], modeldir, os.path.join(modeldir, "build.log"))
+    if rc != 0:
+        sys.exit("Model build failed, see %s" % os.path.join(modeldir, "build.log"))
+    print("Model built in %.0f s" % (time.time() - t0), flush=True)
+    return model
+
+
+def merge_func_cov(args):
+    """Merge the func_cov.dat tables of the runs, see tools/func_cov_merge."""
+    tooldir = os.path.join(args.out, "model")
+    rc, _ = run_logged(["make", "-f", MAKEFILE, "func_cov_merge"], tooldir,
+                       os.path.join(tooldir, "func_cov_merge_build.log"))
+    if rc != 0:
+        print("func_cov_merge build failed, see %s" % os.path.join(tooldir, "func_cov_merge_build.log"))
+        return
+    log = os.path.join(args.out, "func_cov.log")
+    rc, _ = run_logged([os.path.join(tooldir, "func_cov_merge"), "-o", "func_cov_merged.dat",
+                        "-c", "func_cov.csv", args.out], args.out, log)
+    if rc != 0:
+        print("Functional coverage merge failed, see %s" % log)
+        return
+    with open(log, "r") as f:
+        for line in f:
+            if line.startswith("total"):
+                bins, hit, cov = line.split()[1:4]
+                print("Functional coverage: %s/%s bins hit (%s), see %s" % (hit, bins, cov, log))
+
+
+def write_junit(path, name, results, elapsed):
+    fails = sum(r["status"] == "fail" for r in results)
+    errors = sum(r["status"] in ("error", "timeout") for r in results)
+    suite = ET.Element("testsuite", name=name, tests=str(len(results)),
+                       failures=str(fails), errors=str(errors), time="%.2f" % elapsed)
+    for r in results:
+        case = ET.SubElement(suite, "testcase", classname=r["test"],
+                             name="%s.seed_%d" % (r["test"], r["seed"]),
+                             time="%.2f" % r["wall_s"])
+        if r["status"] == "fail":
+            ET.SubElement(case, "failure", message=r.get("message", ""))
+        elif r["status"] != "pass":
+            ET.SubElement(case, "error", message=r.get("message", ""))
+        props = ET.SubElement(case, "properties")
+        for k in ("sim_time_us", "cycles", "cycles_per_s", "kips"):
+            if k in r:
+                ET.SubElement(props, "property", name=k, value=str(r[k]))
+    ET.ElementTree(suite).write(path, encoding="utf-8", xml_declaration=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run a stimulus YAML regression list")
+    parser.add_argument("-l", "--list", required=True, help="regression list, e.g. L0_regression.yml")
+    parser.add_argument("-t", "--tag", action="append", default=[],
+                        help="only run entries with this tag (repeatable, default: all)")
+    parser.add_argument("-o", "--out", default="regression", help="output directory")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(), help="parallel tests")
+    parser.add_argument("--seeds", type=int, default=1,
+                        help="seeds per test: the YAML seed plus random ones")
+    parser.add_argument("--rand-seed", type=int, default=None,
+                        help="seed of the random seed generator, for reproducible lists")
+    parser.add_argument("--shard", default="0/1",
+                        help="i/n: run every n-th test and seed, starting at i")
+    parser.add_argument("--timeout", type=int, default=3600, help="per test limit in s, 0 for none")
+    parser.add_argument("--dut", default="caliptra_ss_top_tb", help="TB top to build")
+    parser.add_argument("--fw-target", default="mcu_program.hex", help="Makefile firmware target")
+    parser.add_argument("--make-arg", dest="make_args", action="append", default=[],
+                        help="extra Makefile variable for model and firmware builds, e.g. SPARSE_MEM=1")
+    parser.add_argument("--plusarg", dest="plusargs", action="append", default=[],
+                        help="extra simulator plusarg, e.g. +NO_BIN_TRACE")
+    parser.add_argument("--threads", type=int, default=1,
+                        help="model threads (VERILATOR_THREADS), used to pin each run with +SIM_CPUS")
+    parser.add_argument("--pin", action="store_true", help="pin every run to its own CPUs")
+    parser.add_argument("--no-build", action="store_true", help="reuse the model in <out>/model")
+    parser.add_argument("--no-func-cov", action="store_true",
+                        help="do not merge the functional coverage of the runs")
+    args = parser.parse_args()
+
+    if "CALIPTRA_SS" not in os.environ:
+        sys.exit("CALIPTRA_SS is not set")
+    shard, nshards = (int(x) for x in args.shard.split("/"))
+    if not 0 <= shard < nshards:
+        sys.exit("Invalid --shard %s" % args.shard)
+    args.out = os.path.abspath(args.out)
+    if args.threads > 1:
+        args.make_args.append("VERILATOR_THREADS=%d" % args.threads)
+
+    tests = load_list(args.list, args.tag)
+    rng = random.Random(args.rand_seed)
+    jobs = expand_seeds(tests, args.seeds, rng)[shard::nshards]
+    if not jobs:
+        sys.exit("No tests selected")
+
+    model = build_model(args)
+    cpus = CpuSlots(args.jobs, args.threads) if args.pin else None
+    print("Running %d test(s) on %d worker(s)" % (len(jobs), args.jobs), flush=True)
+
+    t0 = time.time()
+    results = []
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        futures = [pool.submit(run_test, args, model, name, seed, plusargs, cpus)
+                   for name, seed, plusargs in jobs]
+        for fut in as_completed(futures):
+            r = fut.result()
+            results.append(r)
+            rate = " %.0f cycles/s" % r["cycles_per_s"] if "cycles_per_s" in r else ""
+            print("[%d/%d] %-7s %s seed %d (%.0f s%s)" % (len(results), len(jobs), r["status"].upper(),
+                  r["test"], r["seed"], r["wall_s"], rate), flush=True)
+    elapsed = time.time() - t0
+
+    # Same order as the list, independent of completion order
+    order = {(name, seed): i for i, (name, seed, _) in enumerate(jobs)}
+    results.sort(key=lambda r: order[(r["test"], r["seed"])])
+    npass = sum(r["status"] == "pass" for r in results)
+    summary = {
+        "list": os.path.abspath(args.list),
+        "tags": args.tag,
+        "shard": args.shard,
+        "dut": args.dut,
+        "total": len(results),
+        "passed": npass,
+        "failed": len(results) - npass,
+        "wall_s": round(elapsed, 2),
+        "results": results,
+    }
+    with open(os.path.join(args.out, "summary.json"), "w") as f:
+        json.dump(summary, f, indent=2)
+    write_junit(os.path.join(args.out, "junit.xml"),
+                os.path.splitext(os.path.basename(args.list))[0], results, elapsed)
+
+    print("\n%d/%d passed in %.0f s, summary in %s" % (npass, len(results), elapsed, args.out))
+    if not args.no_func_cov:
+        merge_func_cov(args)
+    for r in results:
+        if r["status"] != "pass":
+            print("  %-7s %s seed %d: %s" % (r["status"].upper(), r["test"], r["seed"], r.get("message", "")))
+    return 0 if npass == len(results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+# SPDX-License-Identifier: Apache-2.0
+#
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Copies the test vector generators and data files of the caliptra_ss_top_tb
+# targets in src/integration/config/compile.yml into the run directory. Called
+# from their sim pre_exec after run_test_makefile, so the targets share one
+# list.
+#
+# Usage: sim_pre_exec.sh <group>...
+#   caliptra - Caliptra core vector generators (ECC, DOE, SHA256, MLDSA)
+#   otp      - fuse_ctrl OTP image
+
+set -e
+
+CALIPTRA_SS=${CALIPTRA_SS:-$(cd "$(dirname "$0")/../.." && pwd)}
+CALIPTRA_RTL=$CALIPTRA_SS/third_party/caliptra-rtl
+DILITHIUM=$CALIPTRA_RTL/submodules/adams-bridge/src/mldsa_top/uvmf/Dilithium_ref/dilithium/ref/test
+
+function copy() {
+    echo "[PRE-EXEC] Copying $1 to $(pwd)"
+    cp "$2" .
+}
+
+for group in "$@"; do
+    case "$group" in
+        caliptra)
+            copy "ECC vector generator"         "$CALIPTRA_RTL/src/ecc/tb/ecc_secp384r1.exe"
+            copy "DOE vector generator"         "$CALIPTRA_RTL/src/doe/tb/doe_test_gen.py"
+            copy "SHA256 wntz vector generator" "$CALIPTRA_RTL/src/sha256/tb/sha256_wntz_test_gen.py"
+            copy "MLDSA vector generator"       "$DILITHIUM/test_dilithium5"
+            copy "MLDSA debug vector generator" "$DILITHIUM/test_dilithium5_debug"
+            copy "mldsa directed vector"        "$CALIPTRA_RTL/src/mldsa/tb/smoke_test_mldsa_vector.hex"
+            ;;
+        otp)
+            copy "otp-img.2048.vmem"            "$CALIPTRA_SS/src/fuse_ctrl/data/otp-img.2048.vmem"
+            ;;
+        *)
+            echo "Unknown pre_exec group '$group'" >&2
+            exit 1
+            ;;
+    esac
+done
@@ -0,0 +1,742 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Offline MCU trace disassembler
+//
+// Reads a binary commit trace written by the trace_sink DPI library and
+// produces the mcu_exec.log (and optionally trace_port.csv) text that the TB
+// used to format in the simulator through dasm.svi. The disassembly is a
+// line-for-line port of dasm.svi, including its GPR shadow used for the
+// effective address annotations, so logs can be diffed against old runs.
+// With the firmware ELF each instruction is also annotated with function+offset.
+//
+// The trace is processed in chunks across threads. GPR state at each chunk
+// start is obtained with a parallel scan of per-chunk register writes, then
+// chunks are formatted in parallel and written out in order.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef TRACE_DASM_ZSTD
+#include <zstd.h>
+#endif
+
+#include "trace_sink.h"
+
+namespace {
+
+const char *const abi_reg[32] = {
+    "zero", "ra", "sp", "gp", "tp",  "t0",  "t1", "t2", "s0", "s1", "a0",
+    "a1",   "a2", "a3", "a4", "a5",  "a6",  "a7", "s2", "s3", "s4", "s5",
+    "s6",   "s7", "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"};
+
+struct Gpr {
+  uint32_t r[32];
+};
+
+// printf-style append
+void fmt(std::string &o, const char *f, ...) __attribute__((format(printf, 2, 3)));
+void fmt(std::string &o, const char *f, ...) {
+  char buf[256];
+  va_list ap;
+  va_start(ap, f);
+  int n = vsnprintf(buf, sizeof(buf), f, ap);
+  va_end(ap);
+  o.append(buf, std::min<size_t>(n, sizeof(buf) - 1));
+}
+
+inline uint32_t bits(uint32_t v, int hi, int lo) {
+  return (v >> lo) & ((hi - lo == 31) ? 0xffffffffu : ((1u << (hi - lo + 1)) - 1));
+}
+inline uint32_t bit(uint32_t v, int b) { return (v >> b) & 1; }
+inline const char *rc(uint32_t r3) { return abi_reg[r3 + 8]; }  // compressed reg
+
+//////////////// 16 bit instructions (dasm16_*) ////////////////
+
+void dasm16_cl(std::string &o, uint32_t op, const Gpr &g) {
+  uint32_t imm = (bits(op, 12, 10) << 3) | (bits(op, 6, 5) << 6);
+  fmt(o, " %s,%d(%s) [%08x]", rc(bits(op, 4, 2)), (int)imm, rc(bits(op, 9, 7)),
+      g.r[bits(op, 9, 7) + 8] + imm);
+}
+
+void dasm16_0(std::string &o, uint32_t op, const Gpr &g) {
+  switch (bits(op, 15, 13)) {
+    case 0: {
+      if ((op & 0xffff) == 0) {
+        o += ".short  0";
+        return;
+      }
+      uint32_t imm = (bits(op, 12, 11) << 4) | (bits(op, 10, 7) << 6) |
+                     (bit(op, 6) << 2) | (bit(op, 5) << 3);
+      fmt(o, "c.addi4spn %s,0x%x", rc(bits(op, 4, 2)), imm);
+      return;
+    }
+    case 1: o += "c.fld  "; dasm16_cl(o, op, g); return;
+    case 2: o += "c.lw   "; dasm16_cl(o, op, g); return;
+    case 3: o += "c.flw  "; dasm16_cl(o, op, g); return;
+    case 5: o += "c.fsd  "; dasm16_cl(o, op, g); return;
+    case 6: o += "c.sw   "; dasm16_cl(o, op, g); return;
+    case 7: o += "c.fsw  "; dasm16_cl(o, op, g); return;
+  }
+  fmt(o, ".short  0x%04x", op & 0xffff);
+}
+
+void dasm16_ci(std::string &o, uint32_t op) {
+  uint32_t imm = bits(op, 6, 2);
+  if (bit(op, 12)) imm |= ~0x1fu;
+  fmt(o, "%s,%d", abi_reg[bits(op, 11, 7)], (int)imm);
+}
+
+void dasm16_cj(std::string &o, uint32_t op, uint32_t pc) {
+  uint32_t imm = (bit(op, 12) << 11) | (bit(op, 11) << 4) | (bits(op, 10, 9) << 8) |
+                 (bit(op, 8) << 10) | (bit(op, 7) << 6) | (bit(op, 6) << 7) |
+                 (bits(op, 5, 3) << 1) | (bit(op, 2) << 5);
+  if (bit(op, 12)) imm |= 0xfffff000u;
+  fmt(o, "0x%x", imm + pc);
+}
+
+void dasm16_cb(std::string &o, uint32_t op, uint32_t pc) {
+  uint32_t imm = (bit(op, 12) << 8) | (bits(op, 11, 10) << 3) | (bits(op, 6, 5) << 6) |
+                 (bits(op, 4, 3) << 1) | (bit(op, 2) << 5);
+  if (bit(op, 12)) imm |= 0xfffffe00u;
+  fmt(o, "%s,0x%x", rc(bits(op, 9, 7)), imm + pc);
+}
+
+// Note: sign taken from op[5] as in dasm.svi
+void dasm16_cr(std::string &o, uint32_t op) {
+  uint32_t imm = bits(op, 6, 2);
+  if (bit(op, 5)) imm |= 0xffffffe0u;
+  switch (bits(op, 11, 10)) {
+    case 0: fmt(o, "c.srli  %s,%u", rc(bits(op, 9, 7)), imm & 0x3f); return;
+    case 1: fmt(o, "c.srai  %s,%u", rc(bits(op, 9, 7)), imm & 0x3f); return;
+    case 2: fmt(o, "c.andi  %s,0x%x", rc(bits(op, 9, 7)), imm); return;
+  }
+  static const char *const mn[4] = {"c.sub   ", "c.xor   ", "c.or    ", "c.and   "};
+  fmt(o, "%s%s,%s", mn[bits(op, 6, 5)], rc(bits(op, 9, 7)), rc(bits(op, 4, 2)));
+}
+
+void dasm16_1_3(std::string &o, uint32_t op) {
+  if (bits(op, 11, 7) == 2) {
+    uint32_t imm = (bit(op, 6) << 4) | (bit(op, 5) << 6) | (bits(op, 4, 3) << 7) |
+                   (bit(op, 2) << 5);
+    if (bit(op, 12)) imm |= 0xfffffe00u;
+    fmt(o, "c.addi16sp %d", (int)imm);
+  } else {
+    uint32_t imm = bits(op, 6, 2) << 12;
+    if (bit(op, 12)) imm |= 0xfffe0000u;
+    fmt(o, "c.lui   %s,0x%x", abi_reg[bits(op, 11, 7)], imm);
+  }
+}
+
+void dasm16_1(std::string &o, uint32_t op, uint32_t pc) {
+  switch (bits(op, 15, 13)) {
+    case 0:
+      if (bits(op, 11, 7) == 0) {
+        o += "c.nop";
+      } else {
+        o += "c.addi  ";
+        dasm16_ci(o, op);
+      }
+      return;
+    case 1: o += "c.jal   "; dasm16_cj(o, op, pc); return;
+    case 2: o += "c.li    "; dasm16_ci(o, op); return;
+    case 3: dasm16_1_3(o, op); return;
+    case 4: dasm16_cr(o, op); return;
+    case 5: o += "c.j     "; dasm16_cj(o, op, pc); return;
+    case 6: o += "c.beqz  "; dasm16_cb(o, op, pc); return;
+    case 7: o += "c.bnez  "; dasm16_cb(o, op, pc); return;
+  }
+}
+
+void dasm16_cls(std::string &o, uint32_t op, bool sh1, const Gpr &g) {
+  uint32_t imm = sh1 ? ((bits(op, 6, 5) << 3) | (bits(op, 4, 2) << 6))
+                     : ((bits(op, 6, 4) << 2) | (bits(op, 3, 2) << 6));
+  imm |= bit(op, 12) << 5;
+  fmt(o, "%s,0x%x [%08x]", abi_reg[bits(op, 11, 7)], imm, g.r[2] + imm);
+}
+
+void dasm16_css(std::string &o, uint32_t op, bool sh1, const Gpr &g) {
+  uint32_t imm = sh1 ? ((bits(op, 12, 10) << 3) | (bits(op, 9, 7) << 6))
+                     : ((bits(op, 12, 9) << 2) | (bits(op, 8, 7) << 6));
+  fmt(o, "%s,0x%x [%08x]", abi_reg[bits(op, 6, 2)], imm, g.r[2] + imm);
+}
+
+void dasm16_2(std::string &o, uint32_t op, const Gpr &g) {
+  switch (bits(op, 15, 13)) {
+    case 0: o += "c.slli  "; dasm16_ci(o, op); return;
+    case 1: o += "c.fldsp "; dasm16_cls(o, op, true, g); return;
+    case 2: o += "c.lwsp  "; dasm16_cls(o, op, false, g); return;
+    case 3: o += "c.flwsp "; dasm16_cls(o, op, false, g); return;
+    case 5: o += "c.fsdsp "; dasm16_css(o, op, true, g); return;
+    case 6: o += "c.swsp  "; dasm16_css(o, op, false, g); return;
+    case 7: o += "c.fswsp "; dasm16_css(o, op, false, g); return;
+  }
+  if (bit(op, 12)) {
+    if (bits(op, 12, 2) == 0)
+      o += "c.ebreak";
+    else if (bits(op, 6, 2) == 0)
+      fmt(o, "c.jalr  %s", abi_reg[bits(op, 11, 7)]);
+    else
+      fmt(o, "c.add   %s,%s", abi_reg[bits(op, 11, 7)], abi_reg[bits(op, 6, 2)]);
+  } else {
+    if (bits(op, 6, 2) == 0)
+      fmt(o, "c.jr    %s", abi_reg[bits(op, 11, 7)]);
+    else
+      fmt(o, "c.mv    %s,%s", abi_reg[bits(op, 11, 7)], abi_reg[bits(op, 6, 2)]);
+  }
+}
+
+void dasm16(std::string &o, uint32_t op, uint32_t pc, const Gpr &g) {
+  switch (op & 3) {
+    case 0: dasm16_0(o, op, g); return;
+    case 1: dasm16_1(o, op, pc); return;
+    case 2: dasm16_2(o, op, g); return;
+  }
+  fmt(o, ".short 0x%04x", op & 0xffff);
+}
+
+//////////////// 32 bit instructions (dasm32_*) ////////////////
+
+inline uint32_t rd(uint32_t op) { return bits(op, 11, 7); }
+inline uint32_t rs1(uint32_t op) { return bits(op, 19, 15); }
+inline uint32_t rs2(uint32_t op) { return bits(op, 24, 20); }
+inline uint32_t f3(uint32_t op) { return bits(op, 14, 12); }
+inline uint32_t sext12(uint32_t v) { return (v & 0x800) ? (v | 0xfffff000u) : v; }
+
+void dasm32_b(std::string &o, uint32_t op, uint32_t pc) {
+  static const char *const mn[8] = {"beq     ", "bne     ", nullptr,    nullptr,
+                                    "blt     ", "bge     ", "bltu    ", "bgeu    "};
+  uint32_t imm = (bit(op, 31) << 12) | (bits(op, 30, 25) << 5) | (bits(op, 11, 8) << 1) |
+                 (bit(op, 7) << 11);
+  if (bit(op, 31)) imm |= 0xfffff000u;
+  if (!mn[f3(op)]) {
+    fmt(o, ".long    0x%08x", op);
+    return;
+  }
+  fmt(o, "%s%s,%s,0x%x", mn[f3(op)], abi_reg[rs1(op)], abi_reg[rs2(op)], imm + pc);
+}
+
+void dasm32_l(std::string &o, uint32_t op, const Gpr &g) {
+  static const char *const mn[8] = {"lb      ", "lh      ", "lw      ", nullptr,
+                                    "lbu     ", "lhu     ", nullptr,    nullptr};
+  uint32_t imm = sext12(bits(op, 31, 20));
+  if (!mn[f3(op)]) {
+    fmt(o, ".long   0x%08x", op);
+    return;
+  }
+  fmt(o, "%s%s,%d(%s) [%08x]", mn[f3(op)], abi_reg[rd(op)], (int)imm, abi_reg[rs1(op)],
+      imm + g.r[rs1(op)]);
+}
+
+void dasm32_s(std::string &o, uint32_t op, const Gpr &g) {
+  static const char *const mn[8] = {"sb      ", "sh      ", "sw      ", nullptr,
+                                    nullptr,    nullptr,    nullptr,    nullptr};
+  uint32_t imm = sext12((bits(op, 31, 25) << 5) | bits(op, 11, 7));
+  if (!mn[f3(op)]) {
+    fmt(o, ".long   0x%08x", op);
+    return;
+  }
+  fmt(o, "%s%s,%d(%s) [%08x]", mn[f3(op)], abi_reg[rs2(op)], (int)imm, abi_reg[rs1(op)],
+      imm + g.r[rs1(op)]);
+}
+
+void dasm32_ai(std::string &o, uint32_t op) {
+  static const char *const mn[8] = {"addi    ", nullptr,    "slti    ", "sltiu   ",
+                                    "xori    ", nullptr,    "ori     ", "andi    "};
+  if (!mn[f3(op)]) {
+    // dasm32_si
+    const char *m = f3(op) == 1 ? "slli" : (bit(op, 30) ? "srai" : "srli");
+    fmt(o, "%s    %s,%s,%d", m, abi_reg[rd(op)], abi_reg[rs1(op)], (int)rs2(op));
+    return;
+  }
+  fmt(o, "%s%s,%s,%d", mn[f3(op)], abi_reg[rd(op)], abi_reg[rs1(op)],
+      (int)sext12(bits(op, 31, 20)));
+}
+
+void dasm32_ar(std::string &o, uint32_t op) {
+  static const char *const mul[8] = {"mul     ", "mulh    ", "mulhsu  ", "mulhu   ",
+                                     "div     ", "divu    ", "rem     ", "remu    "};
+  static const char *const alu[8] = {"add     ", "sll     ", "slt     ", "sltu    ",
+                                     "xor     ", "srl     ", "or      ", "and     "};
+  const char *m;
+  if (bit(op, 25))
+    m = mul[f3(op)];
+  else if (f3(op) == 0 && bit(op, 30))
+    m = "sub     ";
+  else if (f3(op) == 5 && bit(op, 30))
+    m = "sra     ";
+  else
+    m = alu[f3(op)];
+  fmt(o, "%s%s,%s,%s", m, abi_reg[rd(op)], abi_reg[rs1(op)], abi_reg[rs2(op)]);
+}
+
+void dasm32_csr(std::string &o, uint32_t op, bool im) {
+  if (im)
+    fmt(o, "%s,csr_%x,0x%02x", abi_reg[rd(op)], bits(op, 31, 20), rs1(op));
+  else
+    fmt(o, "%s,csr_%x,%s", abi_reg[rd(op)], bits(op, 31, 20), abi_reg[rs1(op)]);
+}
+
+void dasm32_e(std::string &o, uint32_t op) {
+  if (bits(op, 31, 7) == 0) {
+    o += "ecall";
+    return;
+  }
+  if (bits(op, 31, 21) == 0 && bits(op, 19, 7) == 0) {
+    o += "ebreak";
+    return;
+  }
+  switch (f3(op)) {
+    case 1: o += "csrrw   "; dasm32_csr(o, op, false); return;
+    case 2: o += "csrrs   "; dasm32_csr(o, op, false); return;
+    case 3: o += "csrrc   "; dasm32_csr(o, op, false); return;
+    case 5: o += "csrrwi  "; dasm32_csr(o, op, true); return;
+    case 6: o += "csrrsi  "; dasm32_csr(o, op, true); return;
+    case 7: o += "csrrci  "; dasm32_csr(o, op, true); return;
+  }
+  // mret, wfi, ... print nothing, as in dasm.svi
+}
+
+void dasm32_a(std::string &o, uint32_t op, const Gpr &g) {
+  const char *m = nullptr;
+  switch (bits(op, 31, 27)) {
+    case 0x02:
+      fmt(o, "lr.w    %s,(%s) [%08x]", abi_reg[rd(op)], abi_reg[rs1(op)], g.r[rs1(op)]);
+      return;
+    case 0x03:
+      fmt(o, "sc.w    %s,%s,(%s) [%08x]", abi_reg[rd(op)], abi_reg[rs2(op)],
+          abi_reg[rs1(op)], g.r[rs1(op)]);
+      return;
+    case 0x01: m = "amoswap.w"; break;
+    case 0x00: m = "amoadd.w"; break;
+    case 0x04: m = "amoxor.w"; break;
+    case 0x0c: m = "amoand.w"; break;
+    case 0x08: m = "amoor.w"; break;
+    case 0x10: m = "amomin.w"; break;
+    case 0x14: m = "amomax.w"; break;
+    case 0x18: m = "amominu.w"; break;
+    case 0x1c: m = "amomaxu.w"; break;
+    default:
+      fmt(o, ".long 0x%08x", op);
+      return;
+  }
+  fmt(o, "%s %s,%s,(%s) [%08x]", m, abi_reg[rd(op)], abi_reg[rs2(op)], abi_reg[rs1(op)],
+      g.r[rs1(op)]);
+}
+
+void dasm32(std::string &o, uint32_t op, uint32_t pc, const Gpr &g) {
+  switch (op & 0x7f) {
+    case 0x37: fmt(o, "lui     %s,0x%x", abi_reg[rd(op)], op & 0xfffff000u); return;
+    case 0x17: fmt(o, "auipc   %s,0x%x", abi_reg[rd(op)], op & 0xfffff000u); return;
+    case 0x6f: {
+      uint32_t imm = (bit(op, 31) << 20) | (bits(op, 30, 21) << 1) | (bit(op, 20) << 11) |
+                     (bits(op, 19, 12) << 12);
+      if (bit(op, 31)) imm |= 0xfff00000u;
+      fmt(o, "jal     %s,0x%x", abi_reg[rd(op)], imm + pc);
+      return;
+    }
+    case 0x67: {
+      // imm[11:1] = opcode[31:19] truncates to opcode[29:19] in dasm.svi
+      uint32_t imm = bits(op, 29, 19) << 1;
+      if (bit(op, 31)) imm |= 0xfffff000u;
+      fmt(o, "jalr    %s,%s,0x%x", abi_reg[rd(op)], abi_reg[rs1(op)], imm + pc);
+      return;
+    }
+    case 0x63: dasm32_b(o, op, pc); return;
+    case 0x03: dasm32_l(o, op, g); return;
+    case 0x23: dasm32_s(o, op, g); return;
+    case 0x13: dasm32_ai(o, op); return;
+    case 0x33: dasm32_ar(o, op); return;
+    case 0x0f: o += bit(op, 12) ? "fence.i" : "fence"; return;
+    case 0x73: dasm32_e(o, op); return;
+    case 0x2f: dasm32_a(o, op, g); return;
+  }
+  fmt(o, ".long   0x%08x", op);
+}
+
+void dasm(std::string &o, uint32_t op, uint32_t pc, const Gpr &g) {
+  if ((op & 3) == 3)
+    dasm32(o, op, pc, g);
+  else
+    dasm16(o, op, pc, g);
+}
+
+//////////////// ELF symbols ////////////////
+
+struct Sym {
+  uint32_t addr;
+  uint32_t size;
+  std::string name;
+};
+
+// Minimal ELF32 little endian reader: FUNC and NOTYPE symbols from .symtab
+bool load_symbols(const char *path, std::vector<Sym> &syms) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    fprintf(stderr, "trace_dasm: Unable to open %s: %s\n", path, strerror(errno));
+    return false;
+  }
+  std::vector<uint8_t> img;
+  fseek(f, 0, SEEK_END);
+  img.resize(ftell(f));
+  fseek(f, 0, SEEK_SET);
+  bool ok = fread(img.data(), 1, img.size(), f) == img.size();
+  fclose(f);
+
+  auto u16 = [&](size_t off) { return (uint32_t)img[off] | ((uint32_t)img[off + 1] << 8); };
+  auto u32 = [&](size_t off) { return u16(off) | (u16(off + 2) << 16); };
+
+  if (!ok || img.size() < 52 || memcmp(img.data(), "\x7f" "ELF", 4) || img[4] != 1 || img[5] != 1) {
+    fprintf(stderr, "trace_dasm: %s is not a little endian ELF32 file\n", path);
+    return false;
+  }
+  uint32_t shoff = u32(32), shentsize = u16(46), shnum = u16(48);
+  if ((size_t)shoff + (size_t)shnum * shentsize > img.size()) {
+    fprintf(stderr, "trace_dasm: %s: truncated section table\n", path);
+    return false;
+  }
+  for (uint32_t i = 0; i < shnum; i++) {
+    size_t sh = shoff + (size_t)i * shentsize;
+    if (u32(sh + 4) != 2) continue;  // SHT_SYMTAB
+    uint32_t off = u32(sh + 16), size = u32(sh + 20), link = u32(sh + 24), entsize = u32(sh + 36);
+    size_t str_sh = shoff + (size_t)link * shentsize;
+    uint32_t str_off = u32(str_sh + 16), str_size = u32(str_sh + 20);
+    if (!entsize || (size_t)off + size > img.size() || (size_t)str_off + str_size > img.size())
+      continue;
+    for (uint32_t e = 0; e < size / entsize; e++) {
+      size_t s = off + (size_t)e * entsize;
+      uint32_t name = u32(s), value = u32(s + 4), sz = u32(s + 8);
+      uint32_t type = img[s + 12] & 0xf, shndx = u16(s + 14);
+      if ((type != 0 && type != 2) || shndx == 0 || name == 0 || name >= str_size) continue;
+      const char *n = (const char *)&img[str_off + name];
+      if (n[0] == '$' || n[0] == '.') continue;  // mapping symbols, local labels
+      syms.push_back({value, sz, std::string(n, strnlen(n, str_size - name))});
+    }
+  }
+  // Sort by address, FUNC-like (sized) symbols first for equal addresses
+  std::stable_sort(syms.begin(), syms.end(), [](const Sym &a, const Sym &b) {
+    return a.addr != b.addr ? a.addr < b.addr : a.size > b.size;
+  });
+  syms.erase(std::unique(syms.begin(), syms.end(),
+                         [](const Sym &a, const Sym &b) { return a.addr == b.addr; }),
+             syms.end());
+  return true;
+}
+
+const Sym *lookup(const std::vector<Sym> &syms, uint32_t pc) {
+  auto it = std::upper_bound(syms.begin(), syms.end(), pc,
+                             [](uint32_t v, const Sym &s) { return v < s.addr; });
+  if (it == syms.begin()) return nullptr;
+  --it;
+  if (it->size && pc >= it->addr + it->size) return nullptr;
+  return &*it;
+}
+
+//////////////// Trace processing ////////////////
+
+struct Options {
+  const char *trace = nullptr;
+  const char *elf = nullptr;
+  const char *out = "mcu_exec.log";
+  const char *csv = nullptr;
+  unsigned threads = 0;
+  size_t chunk = 1 << 20;
+};
+
+// Register writes done by a chunk: mask of written registers and final values
+struct GprDelta {
+  uint32_t mask = 0;
+  Gpr val{};
+};
+
+// Shadow register written by a record. The sink only marks commit records
+// valid for rd != 0; late writebacks are applied as-is, as the TB did.
+inline bool rec_gpr_write(const trace_rec &r, uint32_t &reg) {
+  if (!(r.rd & TRACE_RD_VALID)) return false;
+  reg = r.rd & TRACE_RD_MASK;
+  return true;
+}
+
+void chunk_delta(const trace_rec *r, size_t n, GprDelta &d) {
+  uint32_t reg = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (rec_gpr_write(r[i], reg)) {
+      d.mask |= 1u << reg;
+      d.val.r[reg] = r[i].wdata;
+    }
+  }
+}
+
+void format_chunk(const trace_rec *r, size_t n, Gpr g, const std::vector<Sym> &syms,
+                  bool csv, std::string &log, std::string &csv_out) {
+  static const char blank_rd[] = "            ";
+  static const char blank_csr[] = "             ";
+  char rdbuf[32], csrbuf[32], seqbuf[16];
+  uint32_t reg = 0;
+
+  log.reserve(n * 96);
+  for (size_t i = 0; i < n; i++) {
+    const trace_rec &t = r[i];
+    if (t.type == TRACE_REC_COMMIT) {
+      if (csv) {
+        fmt(csv_out, "1,00000000,%08x,0,%x,3,%u,%02x,%08x,%u\n", t.pc, t.insn,
+            (t.flags & TRACE_FLAG_EXC) ? 1 : 0, t.ecause, t.tval,
+            (t.flags & TRACE_FLAG_INTR) ? 1 : 0);
+      }
+      bool wr = rec_gpr_write(t, reg);
+      if (wr)
+        snprintf(rdbuf, sizeof(rdbuf), "%s=%08x", abi_reg[reg], t.wdata);
+      if (t.flags & TRACE_FLAG_CSR)
+        snprintf(csrbuf, sizeof(csrbuf), "c%03x=%08x", t.csr_addr & 0xfff, t.csr_wdata);
+      snprintf(seqbuf, sizeof(seqbuf), "#%u", t.seq);
+      fmt(log, "%10lld : %8s 0 %08x %08x%13s %14s ; ", (long long)t.cycle, seqbuf, t.pc,
+          t.insn, wr ? rdbuf : blank_rd, (t.flags & TRACE_FLAG_CSR) ? csrbuf : blank_csr);
+      dasm(log, t.insn, t.pc, g);
+      if (!syms.empty()) {
+        const Sym *s = lookup(syms, t.pc);
+        if (s) fmt(log, "  <%s+0x%x>", s->name.c_str(), t.pc - s->addr);
+      }
+      log += '\n';
+      if (wr) g.r[reg] = t.wdata;
+    } else if (rec_gpr_write(t, reg)) {
+      fmt(log, "%10lld : %32s=%08x                ; %s\n", (long long)t.cycle, abi_reg[reg],
+          t.wdata, t.type == TRACE_REC_NBLOAD ? "nbL" : "nbD");
+      g.r[reg] = t.wdata;
+    }
+  }
+}
+
+// Trace records, either mmapped or decompressed into memory
+struct TraceFile {
+  std::vector<uint8_t> owned;
+  const uint8_t *base = nullptr;
+  size_t size = 0;
+  void *map = nullptr;
+
+  ~TraceFile() {
+    if (map) munmap(map, size);
+  }
+
+  bool open(const char *path) {
+    int fd = ::open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+      fprintf(stderr, "trace_dasm: Unable to open %s: %s\n", path, strerror(errno));
+      if (fd >= 0) close(fd);
+      return false;
+    }
+    size = st.st_size;
+    map = size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    close(fd);
+    if (size && map == MAP_FAILED) {
+      map = nullptr;
+      fprintf(stderr, "trace_dasm: Unable to map %s: %s\n", path, strerror(errno));
+      return false;
+    }
+    base = (const uint8_t *)map;
+    static const uint8_t zstd_magic[4] = {0x28, 0xb5, 0x2f, 0xfd};
+    if (size >= 4 && !memcmp(base, zstd_magic, 4)) return decompress(path);
+    return true;
+  }
+
+  bool decompress(const char *path) {
+#ifdef TRACE_DASM_ZSTD
+    ZSTD_DCtx *dctx = ZSTD_createDCtx();
+    ZSTD_inBuffer in = {base, size, 0};
+    std::vector<uint8_t> buf(ZSTD_DStreamOutSize());
+    while (in.pos < in.size) {
+      ZSTD_outBuffer out = {buf.data(), buf.size(), 0};
+      size_t rc = ZSTD_decompressStream(dctx, &out, &in);
+      if (ZSTD_isError(rc)) {
+        fprintf(stderr, "trace_dasm: %s: %s\n", path, ZSTD_getErrorName(rc));
+        ZSTD_freeDCtx(dctx);
+        return false;
+      }
+      owned.insert(owned.end(), buf.data(), buf.data() + out.pos);
+    }
+    ZSTD_freeDCtx(dctx);
+    munmap(map, size);
+    map = nullptr;
+    base = owned.data();
+    size = owned.size();
+    return true;
+#else
+    fprintf(stderr,
+            "trace_dasm: %s is zstd compressed; rebuild with -DTRACE_DASM_ZSTD -lzstd or "
+            "decompress with `zstd -d` first\n",
+            path);
+    return false;
+#endif
+  }
+};
+
+void usage() {
+  fprintf(stderr,
+          "Usage: trace_dasm [options] mcu_trace.bin\n"
+          "  -e <elf>    firmware ELF, annotate instructions with function+offset\n"
+          "  -o <file>   exec log output (default mcu_exec.log, '-' for stdout)\n"
+          "  -c <file>   also write trace_port.csv style output\n"
+          "  -j <n>      worker threads (default: all cores)\n"
+          "  -n <recs>   records per work chunk (default 1048576)\n");
+}
+
+bool parse_args(int argc, char **argv, Options &opt) {
+  int c;
+  while ((c = getopt(argc, argv, "e:o:c:j:n:h")) != -1) {
+    switch (c) {
+      case 'e': opt.elf = optarg; break;
+      case 'o': opt.out = optarg; break;
+      case 'c': opt.csv = optarg; break;
+      case 'j': opt.threads = strtoul(optarg, nullptr, 0); break;
+      case 'n': opt.chunk = std::max(1ul, strtoul(optarg, nullptr, 0)); break;
+      default: return false;
+    }
+  }
+  if (optind != argc - 1) return false;
+  opt.trace = argv[optind];
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options opt;
+  if (!parse_args(argc, argv, opt)) {
+    usage();
+    return 1;
+  }
+
+  TraceFile tf;
+  if (!tf.open(opt.trace)) return 1;
+  trace_file_hdr hdr;
+  if (tf.size < sizeof(hdr)) {
+    fprintf(stderr, "trace_dasm: %s: truncated header\n", opt.trace);
+    return 1;
+  }
+  memcpy(&hdr, tf.base, sizeof(hdr));
+  if (memcmp(hdr.magic, TRACE_FILE_MAGIC, sizeof(hdr.magic)) || hdr.version != TRACE_FILE_VERSION ||
+      hdr.rec_size != sizeof(trace_rec)) {
+    fprintf(stderr, "trace_dasm: %s: not a version %d trace_sink file\n", opt.trace,
+            TRACE_FILE_VERSION);
+    return 1;
+  }
+  const trace_rec *recs = (const trace_rec *)(tf.base + sizeof(hdr));
+  size_t nrec = (tf.size - sizeof(hdr)) / sizeof(trace_rec);
+  if ((tf.size - sizeof(hdr)) % sizeof(trace_rec))
+    fprintf(stderr, "trace_dasm: %s: ignoring partial record at end of file\n", opt.trace);
+
+  std::vector<Sym> syms;
+  if (opt.elf && !load_symbols(opt.elf, syms)) return 1;
+
+  FILE *log = strcmp(opt.out, "-") ? fopen(opt.out, "w") : stdout;
+  FILE *csv = opt.csv ? fopen(opt.csv, "w") : nullptr;
+  if (!log || (opt.csv && !csv)) {
+    fprintf(stderr, "trace_dasm: Unable to open output: %s\n", strerror(errno));
+    return 1;
+  }
+  fputs("//   Cycle : #inst    0    pc    opcode    reg=value    csr=value     ; mnemonic\n", log);
+
+  unsigned nthreads = opt.threads ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+  size_t nchunks = (nrec + opt.chunk - 1) / opt.chunk;
+
+  // Pass 1: per-chunk register writes in parallel, then a short serial scan
+  // gives the GPR state at the start of every chunk
+  std::vector<GprDelta> delta(nchunks);
+  std::vector<Gpr> start(nchunks);
+  {
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < nthreads; t++) {
+      pool.emplace_back([&] {
+        for (size_t k; (k = next++) < nchunks;)
+          chunk_delta(recs + k * opt.chunk, std::min(opt.chunk, nrec - k * opt.chunk), delta[k]);
+      });
+    }
+    for (auto &th : pool) th.join();
+    Gpr g{};
+    for (size_t k = 0; k < nchunks; k++) {
+      start[k] = g;
+      for (int i = 0; i < 32; i++)
+        if (delta[k].mask & (1u << i)) g.r[i] = delta[k].val.r[i];
+    }
+  }
+
+  // Pass 2: format chunks in parallel, write in order. At most `window`
+  // chunks are buffered to bound memory on long traces.
+  const size_t window = 2 * nthreads;
+  std::vector<std::string> logs(nchunks), csvs(nchunks);
+  std::vector<char> done(nchunks, 0);
+  std::mutex m;
+  std::condition_variable cv;
+  size_t written = 0;
+  std::atomic<size_t> next{0};
+  std::vector<std::thread> pool;
+  for (unsigned t = 0; t < nthreads; t++) {
+    pool.emplace_back([&] {
+      for (;;) {
+        size_t k;
+        {
+          std::unique_lock<std::mutex> lk(m);
+          cv.wait(lk, [&] { return next >= nchunks || next < written + window; });
+          if (next >= nchunks) return;
+          k = next++;
+        }
+        format_chunk(recs + k * opt.chunk, std::min(opt.chunk, nrec - k * opt.chunk), start[k],
+                     syms, csv != nullptr, logs[k], csvs[k]);
+        {
+          std::lock_guard<std::mutex> lk(m);
+          done[k] = 1;
+        }
+        cv.notify_all();
+      }
+    });
+  }
+  for (size_t k = 0; k < nchunks; k++) {
+    {
+      std::unique_lock<std::mutex> lk(m);
+      cv.wait(lk, [&] { return done[k] != 0; });
+    }
+    fwrite(logs[k].data(), 1, logs[k].size(), log);
+    if (csv) fwrite(csvs[k].data(), 1, csvs[k].size(), csv);
+    std::string().swap(logs[k]);
+    std::string().swap(csvs[k]);
+    {
+      std::lock_guard<std::mutex> lk(m);
+      written = k + 1;
+    }
+    cv.notify_all();
+  }
+  for (auto &th : pool) th.join();
+
+  if (log != stdout) fclose(log);
+  if (csv) fclose(csv);
+  fprintf(stderr, "trace_dasm: %zu records, %zu chunks, %u threads\n", nrec, nchunks, nthreads);
+  return 0;
+}